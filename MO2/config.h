@@ -23,10 +23,52 @@
  * - minIns: [1, 2^32]
  * - maxIns: [minIns, 2^32]
  * - delaysPerExec: [0, 2^32]
- * - maxOverallMem: total physical memory (bytes)
+ * - maxOverallMem: total physical memory (bytes, 64-bit; at most 2^31 - 1 frames)
  * - memPerFrame: page/frame size (bytes, must be power of 2)
- * - minMemPerProc, maxMemPerProc: process memory bounds (bytes)
+ * - minMemPerProc, maxMemPerProc: process memory bounds (bytes, below 4 GB -
+ *   processes keep a 32-bit virtual address space)
  * - replacementPolicy: "fifo" or "lru"
+ * - reclaimLowWatermark, reclaimHighWatermark: free-frame thresholds for the
+ *   background reclaimer (frames, 0 disables it; high >= low, and high
+ *   below the page frame count so a just-loaded page is never reclaimed)
+ * - pageFaultLatency: ticks to service a page fault (0 = stall on the core)
+ * - diskScheduler: "none", "fcfs", "sstf" or "scan" (paging disk model)
+ * - diskSeekTicks, diskTransferTicks: paging disk timing (ticks)
+ * - loadControl: "off" or "ws" (working-set based admission/suspension)
+ * - workingSetWindow: working-set window in ticks (>= 1)
+ * - swapOutAfter: ticks a READY/SLEEPING process must wait before the
+ *   medium-term scheduler may swap it out whole (0 = off)
+ * - dispatchPolicy: "fifo" or "affinity" (prefer resident processes)
+ * - dispatchWindow: ready-queue entries examined by affinity dispatch (>= 1)
+ * - prepagePages: recently touched pages prefetched on re-dispatch (0 = off)
+ * - oomKiller: "off", "rss", "youngest" or "faults" (victim selection)
+ * - oomFaultThreshold, oomWindow: kill when more than oomFaultThreshold
+ *   faults happen within one oomWindow-tick window (oomWindow >= 1)
+ * - replacementScope: "global" or "local" (evict own pages once at RSS cap)
+ * - maxRssPerProc: default per-process resident-set cap in bytes (0 = none)
+ * - sharedCode: "off" or "on" (map identical programs to shared code frames)
+ * - ksmScanInterval: ticks between same-page merging scans (0 = off)
+ * - zswapPoolPercent: compressed swap pool size as a percentage of
+ *   maxOverallMem ([0, 100], 0 = off); the pool's frames are taken out of
+ *   the frame pool, so it trades resident pages for cheaper page-ins
+ * - zswapLatency: page-in time in ticks for faults served from the pool
+ * - hugePageFrames: base frames per huge frame (0 = off, else a power of 2 >= 2)
+ * - hugePromoteThreshold: resident pages of an aligned region (counting the
+ *   faulting one) that trigger promotion to a huge frame ([1, hugePageFrames])
+ * - ghostPolicies: "off" or "on" (shadow every replacement policy on the
+ *   live reference stream and report its would-be fault count)
+ * - maxPinnedFrames: frames that may be pinned at once, never chosen as
+ *   replacement victims (0 = pinning off, else below the frame count)
+ * - autoPin: "off" or "on" (pin the current instruction page of each
+ *   running process while it is dispatched; needs maxPinnedFrames > 0)
+ * - codeSegmentBase: virtual address of every program's first instruction;
+ *   code is laid out from there by encoded instruction size, above all data,
+ *   and the largest program must still end below 4 GB.
+ *   The 64-byte symbol table takes the page(s) just below it
+ * - addressModel: READ/WRITE addresses of generated processes, always inside
+ *   the process: "uniform", "sequential" (addressStride-byte steps), "zipf"
+ *   (pages ranked by a Zipf law with exponent zipfSkew) or "phased" (a
+ *   phasePages-page window that moves every phaseLength addresses)
  */
 struct Config {
     int numCPU = 0;                     ///< Number of CPU cores (1-128)
@@ -37,9 +79,41 @@ struct Config {
     uint32_t maxIns = 0;                ///< Maximum instructions per process
     uint32_t delaysPerExec = 0;         ///< Busy-wait delay per instruction (CPU ticks)
 
-    uint32_t maxOverallMem = 0;         ///< Total physical memory in bytes
-    uint32_t memPerFrame = 0;           ///< Frame/page size in bytes (power of 2)
-    uint32_t minMemPerProc = 0;         ///< Minimum process memory allocation (bytes)
-    uint32_t maxMemPerProc = 0;         ///< Maximum process memory allocation (bytes)
+    uint64_t maxOverallMem = 0;         ///< Total physical memory in bytes
+    uint64_t memPerFrame = 0;           ///< Frame/page size in bytes (power of 2)
+    uint64_t minMemPerProc = 0;         ///< Minimum process memory allocation (bytes)
+    uint64_t maxMemPerProc = 0;         ///< Maximum process memory allocation (bytes)
     std::string replacementPolicy = "fifo"; ///< Page replacement: "fifo" or "lru"
+    uint32_t reclaimLowWatermark = 0;   ///< Wake the reclaimer below this many free frames (0 = off)
+    uint32_t reclaimHighWatermark = 0;  ///< Reclaimer evicts until this many frames are free
+    uint32_t pageFaultLatency = 0;      ///< Page-in service time in ticks (0 = blocking fault)
+    std::string diskScheduler = "none"; ///< Paging disk queue order; "none" disables the disk model
+    uint32_t diskSeekTicks = 0;         ///< Full-stroke seek time of the paging disk (ticks)
+    uint32_t diskTransferTicks = 1;     ///< Per-page transfer time of the paging disk (ticks)
+    std::string loadControl = "off";    ///< Load controller: "off" or "ws" (working set)
+    uint32_t workingSetWindow = 20;     ///< Working-set window in ticks
+    uint32_t swapOutAfter = 0;          ///< Idle ticks before whole-process swap-out (0 = off)
+    std::string dispatchPolicy = "fifo";///< Dispatch order: "fifo" or "affinity"
+    uint32_t dispatchWindow = 4;        ///< Affinity dispatch look-ahead from the queue head
+    uint32_t prepagePages = 0;          ///< Max pages prefetched per dispatch (0 = off)
+    std::string oomKiller = "off";      ///< OOM victim score: "off", "rss", "youngest", "faults"
+    uint32_t oomFaultThreshold = 100;   ///< Faults per window that count as thrashing
+    uint32_t oomWindow = 20;            ///< OOM fault-rate window in ticks
+    std::string replacementScope = "global"; ///< Victim scope: "global" or "local"
+    uint32_t maxRssPerProc = 0;         ///< Default per-process RSS cap in bytes (0 = unlimited)
+    std::string sharedCode = "off";     ///< Share code pages of identical programs: "off" or "on"
+    uint32_t ksmScanInterval = 0;       ///< Same-page merging scan period in ticks (0 = off)
+    uint32_t zswapPoolPercent = 0;      ///< Compressed swap pool, % of maxOverallMem (0 = off)
+    uint32_t zswapLatency = 1;          ///< Page-in time for compressed pool hits (ticks)
+    uint32_t hugePageFrames = 0;        ///< Base frames per huge frame (0 = no huge frames)
+    uint32_t hugePromoteThreshold = 2;  ///< Resident pages in a region that trigger promotion
+    std::string ghostPolicies = "off";  ///< Shadow FIFO and LRU with ghost caches: "off" or "on"
+    uint32_t maxPinnedFrames = 0;       ///< Cap on pinned frames (0 = pinning off)
+    std::string autoPin = "off";        ///< Pin the running instruction page: "off" or "on"
+    uint32_t codeSegmentBase = 0x40000000; ///< Virtual address of instruction 0 (page aligned)
+    std::string addressModel = "uniform"; ///< Generated address pattern: "uniform", "sequential", "zipf", "phased"
+    uint32_t addressStride = 2;         ///< Bytes between sequential addresses
+    double zipfSkew = 1.0;              ///< Zipf exponent of the page ranks (> 0)
+    uint32_t phaseLength = 32;          ///< Addresses per phased working set
+    uint32_t phasePages = 4;            ///< Pages in a phased working set
 };
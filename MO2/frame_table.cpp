@@ -0,0 +1,423 @@
+/**
+ * @file frame_table.cpp
+ * @brief Implementation of the chunked frame table and its scan kernels
+ *
+ * Every kernel works on one chunk's packed arrays. The AVX2 versions
+ * handle whole vectors and leave the remainder to the scalar versions,
+ * which are also the complete implementation on CPUs without AVX2.
+ *
+ * The AVX2 kernels are compiled for AVX2 on their own (a function target
+ * attribute on GCC/Clang; MSVC accepts the intrinsics without /arch), so
+ * the rest of the program stays baseline x86-64 and simdAvailable()
+ * decides at runtime whether they may run.
+ */
+
+#include "frame_table.h"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define FRAME_TABLE_AVX2 1
+#define AVX2_TARGET
+#include <immintrin.h>
+#include <intrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FRAME_TABLE_AVX2 1
+#define AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Result of a minimum-tick scan (index SIZE_MAX if nothing qualified)
+ */
+struct TickMin {
+    size_t index = SIZE_MAX;
+    uint64_t tick = UINT64_MAX;
+};
+
+// Frames [from, n) whose owner qualifies (any owner if ownerPid is -1)
+// and which are not pinned
+TickMin minTickScalar(const int32_t* owner, const uint8_t* flags, const uint64_t* ticks,
+                      size_t from, size_t n, int ownerPid) {
+    TickMin best;
+    for (size_t i = from; i < n; ++i) {
+        if (owner[i] == -1 || (flags[i] & FRAME_PINNED)) continue;
+        if (ownerPid != -1 && owner[i] != ownerPid) continue;
+        if (ticks[i] < best.tick) {
+            best.tick = ticks[i];
+            best.index = i;
+        }
+    }
+    return best;
+}
+
+size_t countEqualScalar(const int32_t* owner, size_t from, size_t n, int32_t value) {
+    size_t matches = 0;
+    for (size_t i = from; i < n; ++i) {
+        if (owner[i] == value) matches++;
+    }
+    return matches;
+}
+
+void collectEqualScalar(const int32_t* owner, size_t from, size_t n, int32_t value,
+                        size_t base, std::vector<int>& out) {
+    for (size_t i = from; i < n; ++i) {
+        if (owner[i] == value) out.push_back(static_cast<int>(base + i));
+    }
+}
+
+#if defined(FRAME_TABLE_AVX2)
+
+// Four frames per step; ticks compare as signed (they never reach 2^63)
+AVX2_TARGET TickMin minTickAvx2(const int32_t* owner, const uint8_t* flags, const uint64_t* ticks,
+                                size_t n, int ownerPid) {
+    const __m256i allOnes = _mm256_set1_epi64x(-1);
+    const __m256i wanted = _mm256_set1_epi64x(ownerPid);
+    const __m256i pinned = _mm256_set1_epi64x(FRAME_PINNED);
+    const __m256i step = _mm256_set1_epi64x(4);
+    __m256i bestTick = _mm256_set1_epi64x(INT64_MAX);
+    __m256i bestIndex = _mm256_set1_epi64x(-1);
+    __m256i index = _mm256_setr_epi64x(0, 1, 2, 3);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i own = _mm256_cvtepi32_epi64(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(owner + i)));
+        __m256i tick = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ticks + i));
+        int32_t flagBytes;
+        std::memcpy(&flagBytes, flags + i, sizeof(flagBytes));
+        __m256i flag = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(flagBytes));
+
+        // Free and pinned frames never qualify; a specific owner excludes everyone else
+        __m256i skip = (ownerPid == -1)
+            ? _mm256_cmpeq_epi64(own, allOnes)
+            : _mm256_xor_si256(_mm256_cmpeq_epi64(own, wanted), allOnes);
+        __m256i isPinned = _mm256_cmpeq_epi64(_mm256_and_si256(flag, pinned), pinned);
+        skip = _mm256_or_si256(skip, isPinned);
+        __m256i better = _mm256_andnot_si256(skip, _mm256_cmpgt_epi64(bestTick, tick));
+
+        bestTick = _mm256_blendv_epi8(bestTick, tick, better);
+        bestIndex = _mm256_blendv_epi8(bestIndex, index, better);
+        index = _mm256_add_epi64(index, step);
+    }
+
+    // Each lane kept its first minimum; the lowest index breaks ties across lanes
+    alignas(32) int64_t lanesTick[4];
+    alignas(32) int64_t lanesIndex[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanesTick), bestTick);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanesIndex), bestIndex);
+
+    TickMin best;
+    for (int lane = 0; lane < 4; ++lane) {
+        if (lanesIndex[lane] < 0) continue;
+        uint64_t tick = static_cast<uint64_t>(lanesTick[lane]);
+        size_t at = static_cast<size_t>(lanesIndex[lane]);
+        if (tick < best.tick || (tick == best.tick && at < best.index)) {
+            best.tick = tick;
+            best.index = at;
+        }
+    }
+
+    // Tail indices are higher, so a strict comparison keeps the first minimum
+    TickMin tail = minTickScalar(owner, flags, ticks, i, n, ownerPid);
+    return (tail.tick < best.tick) ? tail : best;
+}
+
+// Eight owners per step
+AVX2_TARGET size_t countEqualAvx2(const int32_t* owner, size_t n, int32_t value) {
+    const __m256i wanted = _mm256_set1_epi32(value);
+    size_t matches = 0;
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i own = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(owner + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(own, wanted)));
+        matches += std::popcount(static_cast<unsigned>(mask));
+    }
+    return matches + countEqualScalar(owner, i, n, value);
+}
+
+AVX2_TARGET void collectEqualAvx2(const int32_t* owner, size_t n, int32_t value, size_t base,
+                                  std::vector<int>& out) {
+    const __m256i wanted = _mm256_set1_epi32(value);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i own = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(owner + i));
+        unsigned mask = static_cast<unsigned>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(own, wanted))));
+        while (mask) {
+            out.push_back(static_cast<int>(base + i + std::countr_zero(mask)));
+            mask &= mask - 1;
+        }
+    }
+    collectEqualScalar(owner, i, n, value, base, out);
+}
+
+#endif
+
+TickMin minTick(bool simd, const int32_t* owner, const uint8_t* flags, const uint64_t* ticks,
+                size_t n, int ownerPid) {
+#if defined(FRAME_TABLE_AVX2)
+    if (simd) return minTickAvx2(owner, flags, ticks, n, ownerPid);
+#endif
+    (void)simd;
+    return minTickScalar(owner, flags, ticks, 0, n, ownerPid);
+}
+
+size_t countEqual(bool simd, const int32_t* owner, size_t n, int32_t value) {
+#if defined(FRAME_TABLE_AVX2)
+    if (simd) return countEqualAvx2(owner, n, value);
+#endif
+    (void)simd;
+    return countEqualScalar(owner, 0, n, value);
+}
+
+void collectEqual(bool simd, const int32_t* owner, size_t n, int32_t value, size_t base,
+                  std::vector<int>& out) {
+#if defined(FRAME_TABLE_AVX2)
+    if (simd) {
+        collectEqualAvx2(owner, n, value, base, out);
+        return;
+    }
+#endif
+    (void)simd;
+    collectEqualScalar(owner, 0, n, value, base, out);
+}
+
+}  // namespace
+
+void FrameTable::reset(size_t frameCount) {
+    count = frameCount;
+    size_t numChunks = (count + CHUNK_FRAMES - 1) / CHUNK_FRAMES;
+
+    chunks.clear();
+    chunks.resize(numChunks);
+    used.assign(numChunks, 0);
+}
+
+size_t FrameTable::chunkLength(size_t c) const {
+    size_t start = c * CHUNK_FRAMES;
+    return (count - start < CHUNK_FRAMES) ? count - start : CHUNK_FRAMES;
+}
+
+FrameTable::Chunk& FrameTable::chunkFor(size_t index) {
+    size_t c = index / CHUNK_FRAMES;
+
+    if (!chunks[c]) {
+        // First touch: build the chunk with every frame free
+        size_t n = chunkLength(c);
+        auto chunk = std::make_unique<Chunk>();
+        chunk->owner = std::make_unique<int32_t[]>(n);
+        chunk->page = std::make_unique<int32_t[]>(n);
+        chunk->flags = std::make_unique<uint8_t[]>(n);            // Zeroed
+        chunk->allocatedTick = std::make_unique<uint64_t[]>(n);   // Zeroed
+        chunk->lastAccessedTick = std::make_unique<uint64_t[]>(n);
+        chunk->hugeBase = std::make_unique<int32_t[]>(n);
+        chunk->sharers = std::make_unique<Mappings[]>(n);
+        std::fill_n(chunk->owner.get(), n, -1);
+        std::fill_n(chunk->page.get(), n, -1);
+        std::fill_n(chunk->hugeBase.get(), n, -1);
+        chunks[c] = std::move(chunk);
+    }
+    return *chunks[c];
+}
+
+int32_t& FrameTable::owner(size_t index) {
+    return chunkFor(index).owner[index % CHUNK_FRAMES];
+}
+
+int32_t& FrameTable::page(size_t index) {
+    return chunkFor(index).page[index % CHUNK_FRAMES];
+}
+
+uint64_t& FrameTable::allocatedTick(size_t index) {
+    return chunkFor(index).allocatedTick[index % CHUNK_FRAMES];
+}
+
+uint64_t& FrameTable::lastAccessedTick(size_t index) {
+    return chunkFor(index).lastAccessedTick[index % CHUNK_FRAMES];
+}
+
+bool FrameTable::hasFlag(size_t index, uint8_t flag) const {
+    const auto& chunk = chunks[index / CHUNK_FRAMES];
+    return chunk && (chunk->flags[index % CHUNK_FRAMES] & flag);
+}
+
+void FrameTable::setFlag(size_t index, uint8_t flag, bool on) {
+    uint8_t& flags = chunkFor(index).flags[index % CHUNK_FRAMES];
+    flags = on ? (flags | flag) : (flags & ~flag);
+}
+
+int32_t& FrameTable::hugeBase(size_t index) {
+    return chunkFor(index).hugeBase[index % CHUNK_FRAMES];
+}
+
+FrameTable::Mappings& FrameTable::sharers(size_t index) {
+    return chunkFor(index).sharers[index % CHUNK_FRAMES];
+}
+
+bool FrameTable::isFree(size_t index) const {
+    const auto& chunk = chunks[index / CHUNK_FRAMES];
+    return !chunk || chunk->owner[index % CHUNK_FRAMES] == -1;
+}
+
+void FrameTable::markUsed(size_t index) {
+    used[index / CHUNK_FRAMES]++;
+}
+
+void FrameTable::markFree(size_t index) {
+    used[index / CHUNK_FRAMES]--;
+}
+
+int FrameTable::findFree() const {
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        size_t n = chunkLength(c);
+        if (used[c] >= n) continue;  // Chunk full
+
+        if (!chunks[c]) return static_cast<int>(c * CHUNK_FRAMES);
+        const int32_t* owners = chunks[c]->owner.get();
+        for (size_t i = 0; i < n; ++i) {
+            if (owners[i] == -1) return static_cast<int>(c * CHUNK_FRAMES + i);
+        }
+    }
+    return -1;
+}
+
+int FrameTable::findFreeRun(size_t length, size_t limit) const {
+    limit = std::min(limit, count);
+    size_t start = 0;
+    while (length > 0 && start + length <= limit) {
+        size_t c = start / CHUNK_FRAMES;
+        size_t available = chunkLength(c) - used[c];
+        if (available == 0 || (length <= CHUNK_FRAMES && available < length)) {
+            // No run can start in this chunk; resume at the next aligned start past it
+            start = ((c + 1) * CHUNK_FRAMES + length - 1) / length * length;
+            continue;
+        }
+
+        // Empty chunks inside the run need no per-frame check
+        size_t end = start + length;
+        size_t i = start;
+        while (i < end) {
+            size_t chunk = i / CHUNK_FRAMES;
+            if (used[chunk] == 0) i = std::min(end, (chunk + 1) * CHUNK_FRAMES);
+            else if (isFree(i)) ++i;
+            else break;
+        }
+        if (i == end) return static_cast<int>(start);
+        start = end;
+    }
+    return -1;
+}
+
+int FrameTable::findVictim(bool leastRecent, int ownerPid) const {
+    int victim = -1;
+    uint64_t bestTick = UINT64_MAX;
+
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (!chunks[c] || used[c] == 0) continue;  // Nothing to evict here
+
+        const Chunk& chunk = *chunks[c];
+        const uint64_t* ticks = leastRecent ? chunk.lastAccessedTick.get()
+                                            : chunk.allocatedTick.get();
+        TickMin best = minTick(simd, chunk.owner.get(), chunk.flags.get(), ticks,
+                               chunkLength(c), ownerPid);
+
+        // Strict comparison: earlier chunks win ties
+        if (best.index != SIZE_MAX && best.tick < bestTick) {
+            bestTick = best.tick;
+            victim = static_cast<int>(c * CHUNK_FRAMES + best.index);
+        }
+    }
+    return victim;
+}
+
+std::vector<int> FrameTable::framesOwnedBy(int pid) const {
+    std::vector<int> owned;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (!chunks[c] || used[c] == 0) continue;
+        collectEqual(simd, chunks[c]->owner.get(), chunkLength(c), pid, c * CHUNK_FRAMES, owned);
+    }
+    return owned;
+}
+
+std::vector<int> FrameTable::sharedFrames() const {
+    std::vector<int> shared;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (!chunks[c] || used[c] == 0) continue;
+        for (size_t i = 0; i < chunkLength(c); ++i) {
+            if (!chunks[c]->sharers[i].empty()) shared.push_back(static_cast<int>(c * CHUNK_FRAMES + i));
+        }
+    }
+    return shared;
+}
+
+size_t FrameTable::countOwnedBy(int pid) const {
+    size_t owned = 0;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (!chunks[c]) continue;
+        owned += countEqual(simd, chunks[c]->owner.get(), chunkLength(c), pid);
+    }
+    return owned;
+}
+
+size_t FrameTable::countUsed() const {
+    size_t occupied = 0;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (!chunks[c]) continue;
+        size_t n = chunkLength(c);
+        occupied += n - countEqual(simd, chunks[c]->owner.get(), n, -1);
+    }
+    return occupied;
+}
+
+size_t FrameTable::getMaterializedChunks() const {
+    size_t n = 0;
+    for (const auto& chunk : chunks) {
+        if (chunk) n++;
+    }
+    return n;
+}
+
+size_t FrameTable::getMetadataBytes() const {
+    constexpr size_t perFrame = 3 * sizeof(int32_t) + sizeof(uint8_t) +
+                                2 * sizeof(uint64_t) + sizeof(Mappings);
+
+    size_t bytes = chunks.size() * (sizeof(std::unique_ptr<Chunk>) + sizeof(uint32_t));
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (chunks[c]) bytes += sizeof(Chunk) + chunkLength(c) * perFrame;
+    }
+    return bytes;
+}
+
+bool FrameTable::simdAvailable() {
+#if defined(FRAME_TABLE_AVX2) && defined(_MSC_VER)
+    // AVX2 needs the CPU feature bit and the OS saving YMM state (OSXSAVE + XCR0)
+    static const bool supported = [] {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }();
+    return supported;
+#elif defined(FRAME_TABLE_AVX2)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void FrameTable::setSimd(bool on) {
+    simd = on && simdAvailable();
+}
@@ -0,0 +1,166 @@
+/**
+ * @file frame_table.h
+ * @brief Physical frame metadata, allocated in chunks on first use
+ *
+ * Large simulated RAM (tens of GB, millions of frames) must not cost a
+ * full record per frame at startup. The table is split into fixed-size
+ * chunks that are only materialized when one of their frames is first
+ * assigned; a frame in a missing chunk is free by definition.
+ *
+ * Each chunk stores its fields as separate packed arrays (structure of
+ * arrays), so victim searches and occupancy counts stream only the owner
+ * and tick arrays they compare. Those scans use AVX2 kernels when the
+ * CPU supports AVX2 (checked once at runtime) and a scalar loop otherwise.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @enum FrameFlag
+ * @brief Per-frame state bits kept in the packed flags array
+ */
+enum FrameFlag : uint8_t {
+    FRAME_DIRTY       = 1 << 0,  ///< Modified since it was loaded
+    FRAME_PREPAGED    = 1 << 1,  ///< Loaded by prepaging and not referenced yet
+    FRAME_HUGE_FILLED = 1 << 2,  ///< Loaded by a huge-frame promotion and not referenced yet
+    FRAME_PINNED      = 1 << 3   ///< Never chosen as a replacement victim
+};
+
+/**
+ * @class FrameTable
+ * @brief Chunked structure-of-arrays frame pool
+ *
+ * Field accessors return references into the chunk arrays and
+ * materialize the chunk on first use. Chunks are kept once materialized,
+ * so references stay valid until reset(). Per-chunk occupancy counts let
+ * free-frame searches skip full chunks. Scans visit only materialized
+ * chunks; frames in the others are free.
+ */
+class FrameTable {
+public:
+    static constexpr size_t CHUNK_FRAMES = 4096;  ///< Frames per chunk
+
+    using Mappings = std::vector<std::pair<int, int>>;  ///< (pid, page) pairs
+
+    /**
+     * @brief Drop all chunks and resize the (virtual) pool
+     * @param count Number of frames
+     */
+    void reset(size_t count);
+
+    size_t size() const { return count; }  ///< Number of frames
+
+    // Hot fields (scanned by replacement and statistics)
+    int32_t& owner(size_t index);             ///< Owning pid (-1 free, <= -2 shared code)
+    int32_t& page(size_t index);              ///< Virtual page mapped to the frame
+    uint64_t& allocatedTick(size_t index);    ///< CPU tick the page arrived (FIFO)
+    uint64_t& lastAccessedTick(size_t index); ///< CPU tick of the last reference (LRU)
+
+    /**
+     * @brief Test a FrameFlag bit (never materializes a chunk)
+     */
+    bool hasFlag(size_t index, uint8_t flag) const;
+
+    /**
+     * @brief Set or clear a FrameFlag bit
+     */
+    void setFlag(size_t index, uint8_t flag, bool on);
+
+    // Cold fields
+    int32_t& hugeBase(size_t index);          ///< First frame of its huge frame (-1 if none)
+    Mappings& sharers(size_t index);          ///< Extra mappings while shared copy-on-write
+
+    /**
+     * @brief True if a frame has no owner (never materializes a chunk)
+     */
+    bool isFree(size_t index) const;
+
+    /**
+     * @brief Record that a free frame was just given an owner
+     */
+    void markUsed(size_t index);
+
+    /**
+     * @brief Record that an occupied frame was just freed
+     */
+    void markFree(size_t index);
+
+    /**
+     * @brief Lowest-numbered free frame
+     * @return Frame index, or -1 if every frame is occupied
+     */
+    int findFree() const;
+
+    /**
+     * @brief Lowest-numbered run of free frames aligned to its length
+     * @param length Frames in the run
+     * @param limit Only consider frames below this index
+     * @return First frame of the run, or -1 if none is free
+     *
+     * Chunks with too few free frames to hold a run are skipped without
+     * looking at their frames.
+     */
+    int findFreeRun(size_t length, size_t limit) const;
+
+    /**
+     * @brief Unpinned occupied frame with the smallest tick (lowest index on ties)
+     * @param leastRecent Compare lastAccessedTick (LRU) instead of allocatedTick (FIFO)
+     * @param ownerPid Only consider this owner's frames (-1 = any owner)
+     * @return Frame index, or -1 if no frame qualifies
+     */
+    int findVictim(bool leastRecent, int ownerPid = -1) const;
+
+    /**
+     * @brief Frames owned by a pid, in index order
+     */
+    std::vector<int> framesOwnedBy(int pid) const;
+
+    /**
+     * @brief Frames with at least one copy-on-write sharer, in index order
+     */
+    std::vector<int> sharedFrames() const;
+
+    size_t countOwnedBy(int pid) const;  ///< Frames owned by a pid (owner compare kernel)
+    size_t countUsed() const;            ///< Occupied frames (owner compare kernel)
+
+    size_t getMaterializedChunks() const;  ///< Chunks allocated so far
+    size_t getMetadataBytes() const;       ///< Host bytes held by frame metadata
+
+    static bool simdAvailable();     ///< True if the AVX2 kernels were compiled in and the CPU runs them
+    void setSimd(bool on);           ///< Use the AVX2 kernels when available (default on)
+
+private:
+    /**
+     * @struct Chunk
+     * @brief Packed field arrays for CHUNK_FRAMES consecutive frames
+     */
+    struct Chunk {
+        std::unique_ptr<int32_t[]> owner;
+        std::unique_ptr<int32_t[]> page;
+        std::unique_ptr<uint8_t[]> flags;
+        std::unique_ptr<uint64_t[]> allocatedTick;
+        std::unique_ptr<uint64_t[]> lastAccessedTick;
+        std::unique_ptr<int32_t[]> hugeBase;
+        std::unique_ptr<Mappings[]> sharers;
+    };
+
+    size_t count = 0;                           ///< Frames in the pool
+    std::vector<std::unique_ptr<Chunk>> chunks; ///< Chunk storage (null = never used)
+    std::vector<uint32_t> used;                 ///< Occupied frames per chunk
+    bool simd = simdAvailable();                ///< Vector kernels enabled
+
+    /**
+     * @brief Frames in chunk c (the last chunk may be short)
+     */
+    size_t chunkLength(size_t c) const;
+
+    /**
+     * @brief Chunk holding a frame, materialized with every frame free
+     */
+    Chunk& chunkFor(size_t index);
+};
@@ -0,0 +1,54 @@
+/**
+ * @file ghost_cache.cpp
+ * @brief Implementation of the shadow page cache
+ */
+
+#include "ghost_cache.h"
+#include <iterator>
+
+uint64_t GhostCache::keyOf(int space, int pageNum) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(space)) << 32) |
+           static_cast<uint32_t>(pageNum);
+}
+
+void GhostCache::reset(size_t slots) {
+    capacity = slots;
+    order.clear();
+    index.clear();
+    references = 0;
+    faults = 0;
+}
+
+bool GhostCache::access(int space, int pageNum) {
+    references++;
+    uint64_t key = keyOf(space, pageNum);
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        // LRU: a hit makes the page the most recent; FIFO keeps arrival order
+        if (lru) order.splice(order.end(), order, it->second);
+        return true;
+    }
+
+    faults++;
+    if (capacity == 0) return false;
+
+    if (order.size() >= capacity) {
+        index.erase(order.front());
+        order.pop_front();
+    }
+    order.push_back(key);
+    index[key] = std::prev(order.end());
+    return false;
+}
+
+void GhostCache::dropSpace(int space) {
+    for (auto it = order.begin(); it != order.end(); ) {
+        if (static_cast<int>(static_cast<uint32_t>(*it >> 32)) == space) {
+            index.erase(*it);
+            it = order.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * @file ghost_cache.h
+ * @brief Metadata-only page cache used to shadow a replacement policy
+ *
+ * A ghost cache sees the same reference stream as physical memory and
+ * has the same number of slots, but holds only (address space, page)
+ * keys. Its miss count is the fault count the policy would have had if it
+ * were the one configured.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class GhostCache
+ * @brief FIFO or LRU cache of page keys with hit/miss counters
+ */
+class GhostCache {
+public:
+    /**
+     * @param policy "fifo" or "lru"
+     */
+    explicit GhostCache(const std::string& policy) : policy(policy), lru(policy == "lru") {}
+
+    /**
+     * @brief Empty the cache, resize it and clear the counters
+     * @param capacity Pages the cache holds (physical frame count)
+     */
+    void reset(size_t capacity);
+
+    /**
+     * @brief Reference a page
+     * @param space Address space (pid or shared code segment)
+     * @param pageNum Virtual page number
+     * @return true on a hit, false on a (ghost) fault
+     */
+    bool access(int space, int pageNum);
+
+    /**
+     * @brief Forget every page of an address space (process exited)
+     */
+    void dropSpace(int space);
+
+    const std::string& getPolicy() const { return policy; }  ///< "fifo" or "lru"
+    uint64_t getReferences() const { return references; }  ///< Pages referenced since reset()
+    uint64_t getFaults() const { return faults; }          ///< Misses since reset()
+
+private:
+    std::string policy;                 ///< Replacement order
+    bool lru;                           ///< Hits refresh a page's position
+    size_t capacity = 0;                ///< Slots (0 = every reference misses)
+    std::list<uint64_t> order;          ///< Keys, next victim at the front
+    std::unordered_map<uint64_t, std::list<uint64_t>::iterator> index; ///< Key -> position in order
+    uint64_t references = 0;            ///< access() calls
+    uint64_t faults = 0;                ///< access() misses
+
+    /**
+     * @brief Pack (space, page) into one key
+     */
+    static uint64_t keyOf(int space, int pageNum);
+};
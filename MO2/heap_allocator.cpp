@@ -0,0 +1,155 @@
+/**
+ * @file heap_allocator.cpp
+ * @brief Implementation of the per-process heap
+ */
+
+#include "heap_allocator.h"
+#include <algorithm>
+#include <bit>
+
+void HeapAllocator::configure(uint32_t heapBase, uint32_t end, uint32_t size) {
+    base = heapBase;
+    pageSize = size;
+    size_t numPages = (end > heapBase && size > 0) ? (end - heapBase) / size : 0;
+    pages.assign(numPages, HeapPage{});
+
+    // Classes MIN_BLOCK, 2*MIN_BLOCK, ... up to half a page; bigger requests take whole pages
+    size_t classes = 0;
+    for (uint32_t block = MIN_BLOCK; size > 0 && block <= size / 2; block *= 2) {
+        classes++;
+    }
+    partial.assign(classes, {});
+    blocks.clear();
+    liveBytes = 0;
+    pagesInUse = 0;
+}
+
+uint32_t HeapAllocator::allocate(uint32_t size) {
+    if (pages.empty()) return 0;
+    size = std::max<uint32_t>(size, 1);
+
+    uint32_t addr = 0;
+    if (!partial.empty() && size <= MIN_BLOCK << (partial.size() - 1)) {
+        // Small block: first free slot of the lowest page of its class
+        uint32_t blockSize = std::bit_ceil(std::max(size, MIN_BLOCK));
+        std::set<uint32_t>& candidates = partial[classOf(blockSize)];
+        if (candidates.empty()) {
+            int fresh = findFreeRun(1);
+            if (fresh == -1) return 0;
+            HeapPage& page = pages[fresh];
+            page.kind = PageKind::SLAB;
+            page.blockSize = blockSize;
+            page.usedBlocks = 0;
+            page.used.assign(pageSize / blockSize, false);
+            pagesInUse++;
+            candidates.insert(static_cast<uint32_t>(fresh));
+        }
+
+        uint32_t index = *candidates.begin();
+        HeapPage& page = pages[index];
+        auto slot = std::find(page.used.begin(), page.used.end(), false);
+        *slot = true;
+        if (++page.usedBlocks == page.used.size()) candidates.erase(candidates.begin());
+        addr = pageAddress(index) + static_cast<uint32_t>(slot - page.used.begin()) * blockSize;
+    } else {
+        // Large block: first fit over runs of whole pages
+        uint32_t n = (size + pageSize - 1) / pageSize;
+        int first = findFreeRun(n);
+        if (first == -1) return 0;
+        for (uint32_t i = 0; i < n; ++i) {
+            pages[first + i].kind = PageKind::LARGE;
+            pages[first + i].runPages = 0;
+        }
+        pages[first].runPages = n;
+        pagesInUse += n;
+        addr = pageAddress(first);
+    }
+
+    blocks[addr] = size;
+    liveBytes += size;
+    return addr;
+}
+
+bool HeapAllocator::overlapsLive(uint32_t addr, uint64_t bytes) const {
+    size_t from = 0, to = 0;
+    pageSpan(addr, bytes, from, to);
+    for (size_t i = from; i < to; ++i) {
+        if (pages[i].kind == PageKind::SLAB || pages[i].kind == PageKind::LARGE) return true;
+    }
+    return false;
+}
+
+bool HeapAllocator::reserve(uint32_t addr, uint64_t bytes) {
+    if (overlapsLive(addr, bytes)) return false;
+    size_t from = 0, to = 0;
+    pageSpan(addr, bytes, from, to);
+    for (size_t i = from; i < to; ++i) {
+        pages[i].kind = PageKind::RESERVED;
+    }
+    return true;
+}
+
+bool HeapAllocator::release(uint32_t addr, std::vector<uint32_t>& freedPages) {
+    auto block = blocks.find(addr);
+    if (block == blocks.end()) return false;
+    liveBytes -= block->second;
+    blocks.erase(block);
+
+    size_t index = (addr - base) / pageSize;
+    HeapPage& page = pages[index];
+    if (page.kind == PageKind::SLAB) {
+        std::set<uint32_t>& candidates = partial[classOf(page.blockSize)];
+        page.used[(addr - pageAddress(index)) / page.blockSize] = false;
+        if (--page.usedBlocks > 0) {
+            candidates.insert(static_cast<uint32_t>(index));
+            return true;
+        }
+
+        // Last block gone: the page leaves its class
+        candidates.erase(static_cast<uint32_t>(index));
+        page = HeapPage{};
+        pagesInUse--;
+        freedPages.push_back(pageAddress(index));
+        return true;
+    }
+
+    uint32_t n = page.runPages;
+    for (uint32_t i = 0; i < n; ++i) {
+        pages[index + i] = HeapPage{};
+        freedPages.push_back(pageAddress(index + i));
+    }
+    pagesInUse -= n;
+    return true;
+}
+
+double HeapAllocator::getFragmentation() const {
+    if (pagesInUse == 0) return 0.0;
+    return 1.0 - static_cast<double>(liveBytes) / (static_cast<double>(pagesInUse) * pageSize);
+}
+
+int HeapAllocator::findFreeRun(uint32_t n) const {
+    uint32_t run = 0;
+    for (size_t i = 0; i < pages.size(); ++i) {
+        run = (pages[i].kind == PageKind::FREE) ? run + 1 : 0;
+        if (run == n) return static_cast<int>(i + 1 - n);
+    }
+    return -1;
+}
+
+void HeapAllocator::pageSpan(uint32_t addr, uint64_t bytes, size_t& from, size_t& to) const {
+    from = to = 0;
+    if (pages.empty()) return;
+    uint64_t first = std::max<uint64_t>(addr, base);
+    uint64_t last = std::min<uint64_t>(static_cast<uint64_t>(addr) + bytes, pageAddress(pages.size()));
+    if (first >= last) return;
+    from = static_cast<size_t>((first - base) / pageSize);
+    to = static_cast<size_t>((last - base + pageSize - 1) / pageSize);
+}
+
+size_t HeapAllocator::classOf(uint32_t blockSize) {
+    return static_cast<size_t>(std::countr_zero(blockSize / MIN_BLOCK));
+}
+
+uint32_t HeapAllocator::pageAddress(size_t index) const {
+    return base + static_cast<uint32_t>(index) * pageSize;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file heap_allocator.h
+ * @brief Per-process heap for the MALLOC and FREE instructions
+ *
+ * The heap manages a page-aligned range of a process's virtual address
+ * space. Small requests are rounded up to a power-of-two size class and
+ * carved out of pages dedicated to that class (one class per page). Larger
+ * requests get a run of whole pages. A page whose last block is freed goes
+ * back to the free page pool and is reported to the caller, so the frame
+ * behind it can be returned to the memory manager. Reserved pages (file
+ * mappings inside the range) are never handed out.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class HeapAllocator
+ * @brief Size-class allocator over the pages of one address space
+ */
+class HeapAllocator {
+public:
+    static constexpr uint32_t MIN_BLOCK = 16;  ///< Smallest size class in bytes
+
+    /**
+     * @brief Set the managed range and drop every allocation
+     * @param heapBase First heap address (page aligned, above 0 so 0 can mean failure)
+     * @param end One past the last heap address (rounded down to a page)
+     * @param size Page size in bytes
+     */
+    void configure(uint32_t heapBase, uint32_t end, uint32_t size);
+
+    bool isConfigured() const { return pageSize != 0; }  ///< True once configure() ran
+
+    /**
+     * @brief Allocate a block
+     * @param size Requested bytes (0 is treated as 1)
+     * @return Block address, or 0 if no free block or page run fits
+     */
+    uint32_t allocate(uint32_t size);
+
+    /**
+     * @brief True if a heap page touched by [addr, addr + bytes) holds a live block
+     */
+    bool overlapsLive(uint32_t addr, uint64_t bytes) const;
+
+    /**
+     * @brief Take pages out of the heap for good (e.g. a file mapping)
+     * @param addr Start of the range
+     * @param bytes Length of the range; every heap page it touches is reserved
+     * @return false (and nothing reserved) if overlapsLive() for the range
+     */
+    bool reserve(uint32_t addr, uint64_t bytes);
+
+    /**
+     * @brief Free a block returned by allocate()
+     * @param addr Block address
+     * @param freedPages Receives the addresses of pages left with no live block
+     * @return false if addr is not the start of a live block
+     */
+    bool release(uint32_t addr, std::vector<uint32_t>& freedPages);
+
+    uint64_t getLiveBytes() const { return liveBytes; }           ///< Bytes requested by live blocks
+    size_t getLiveBlocks() const { return blocks.size(); }        ///< Live blocks
+    size_t getPagesInUse() const { return pagesInUse; }           ///< Pages holding any live block
+    uint32_t getPageSize() const { return pageSize; }             ///< Page size (0 if unconfigured)
+
+    /**
+     * @brief Share of in-use heap pages not covered by requested bytes
+     *        (size-class rounding, partly used slab pages, run tails)
+     */
+    double getFragmentation() const;
+
+private:
+    /**
+     * @enum PageKind
+     * @brief What a heap page is currently used for
+     */
+    enum class PageKind : uint8_t {
+        FREE,           ///< In the free page pool
+        SLAB,           ///< Split into blocks of one size class
+        LARGE,          ///< Part of a multi-page block
+        RESERVED        ///< Never handed out (file mapping)
+    };
+
+    /**
+     * @struct HeapPage
+     * @brief Bookkeeping for one heap page
+     */
+    struct HeapPage {
+        PageKind kind = PageKind::FREE;
+        uint32_t blockSize = 0;      ///< SLAB: size class in bytes
+        uint32_t usedBlocks = 0;     ///< SLAB: live blocks on the page
+        uint32_t runPages = 0;       ///< LARGE: pages in the run (first page only)
+        std::vector<bool> used;      ///< SLAB: live flag per block slot
+    };
+
+    uint32_t base = 0;                            ///< First heap address
+    uint32_t pageSize = 0;                        ///< Page size (0 = unconfigured)
+    std::vector<HeapPage> pages;                  ///< Heap pages, lowest address first
+    std::vector<std::set<uint32_t>> partial;      ///< Per size class: SLAB pages with a free slot
+    std::unordered_map<uint32_t, uint32_t> blocks;///< Live block address -> requested bytes
+    uint64_t liveBytes = 0;                       ///< Sum of requested bytes of live blocks
+    size_t pagesInUse = 0;                        ///< Pages not FREE
+
+    /**
+     * @brief First run of n free pages
+     * @return Index of its first page, or -1 if none
+     */
+    int findFreeRun(uint32_t n) const;
+
+    /**
+     * @brief Heap pages [from, to) touched by a range (empty if outside the heap)
+     */
+    void pageSpan(uint32_t addr, uint64_t bytes, size_t& from, size_t& to) const;
+
+    /**
+     * @brief Size class index for a block size (MIN_BLOCK << index)
+     */
+    static size_t classOf(uint32_t blockSize);
+
+    /**
+     * @brief Address of the first byte of a heap page
+     */
+    uint32_t pageAddress(size_t index) const;
+};
@@ -13,6 +13,7 @@
 #include "config.h"
 #include "scheduler.h"
 #include <iostream>
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <utility>
@@ -24,11 +25,17 @@
 #include <vector>
 #include <list>
 #include <optional>
+#include <functional>
 #include <mutex>
 #include <cstdlib>
+#include <climits>
 #include <ctime>
+#include <chrono>
+#include <random>
 
 #include "memory_manager.h"
+#include "frame_table.h"
+#include "trace_replay.h"
 
 using namespace std;
 
@@ -48,7 +55,8 @@ bool verboseMode = true;    ///< Enable verbose logging output
  * @param name Process name to search for
  * @return Pointer to process if found, nullptr otherwise
  * 
- * Searches in order: ready_queue, sleeping_queue, cpu_cores, finished_queue
+ * Searches in order: ready_queue, sleeping_queue, blocked_queue, suspended_queue,
+ * swapped_queue, cpu_cores, finished_queue
  */
 Process* find_process(const std::string& name) {
     for (auto& p : ready_queue)
@@ -57,6 +65,15 @@ Process* find_process(const std::string& name) {
     for (auto& p : sleeping_queue)
         if (p.name == name) return &p;
 
+    for (auto& p : blocked_queue)
+        if (p.name == name) return &p;
+
+    for (auto& p : suspended_queue)
+        if (p.name == name) return &p;
+
+    for (auto& p : swapped_queue)
+        if (p.name == name) return &p;
+
     for (auto& core : cpu_cores)
         if (core.has_value() && core->name == name)
             return &core.value();
@@ -100,7 +117,7 @@ tuple<int, int, double> calculate_cpu_utilization() {
  * @return String containing process list (one per line)
  * 
  * Format: "processName [STATE]\n"
- * States: READY, RUNNING, SLEEPING, FINISHED
+ * States: READY, RUNNING, SLEEPING, BLOCKED, SUSPENDED, SWAPPED, FINISHED, OOM-KILLED
  */
 string generate_process_list() {
     stringstream ss;
@@ -108,7 +125,11 @@ string generate_process_list() {
     for (auto& c : cpu_cores)
         if (c.has_value())         ss << c->name << " [RUNNING]\n";
     for (auto& p : sleeping_queue) ss << p.name << " [SLEEPING]\n";
-    for (auto& p : finished_queue) ss << p.name << " [FINISHED]\n";
+    for (auto& p : blocked_queue)  ss << p.name << " [BLOCKED]\n";
+    for (auto& p : suspended_queue) ss << p.name << " [SUSPENDED]\n";
+    for (auto& p : swapped_queue)  ss << p.name << " [SWAPPED]\n";
+    for (auto& p : finished_queue)
+        ss << p.name << (p.state == ProcessState::OOM_KILLED ? " [OOM-KILLED]\n" : " [FINISHED]\n");
     return ss.str();
 }
 
@@ -153,8 +174,8 @@ void showHelp() {
     cout << "\nAvailable Commands\n";
     cout << "------------------\n";
     cout << "initialize\n";
-    cout << "screen -s <name> <memsize>\n";
-    cout << "screen -c <name> <memsize> \"<instructions>\"\n";
+    cout << "screen -s <name> <memsize> [max-rss]\n";
+    cout << "screen -c <name> <memsize> [max-rss] \"<instructions>\"\n";
     cout << "screen -r <name>\n";
     cout << "screen -ls\n";
     cout << "scheduler-start\n";
@@ -162,6 +183,10 @@ void showHelp() {
     cout << "report-util\n";
     std::cout << "process-smi\n";
     std::cout << "vmstat\n";
+    cout << "frame-bench [frames]\n";
+    cout << "trace-start <file>\n";
+    cout << "trace-stop\n";
+    cout << "trace-replay <file> [fifo|lru|both] [mem-per-frame] [mem-size...]\n";
     cout << "exit\n\n";
 
     cout << "Inside screen:\n";
@@ -190,6 +215,38 @@ void showHelp() {
  * - min-mem-per-proc <uint32>
  * - max-mem-per-proc <uint32>
  * - replacement-policy <string>
+ * - reclaim-low-watermark <uint32> (free frames)
+ * - reclaim-high-watermark <uint32> (free frames)
+ * - page-fault-latency <uint32> (ticks)
+ * - disk-scheduler <string> ("none", "fcfs", "sstf" or "scan")
+ * - disk-seek-ticks <uint32>
+ * - disk-transfer-ticks <uint32>
+ * - load-control <string> ("off" or "ws")
+ * - working-set-window <uint32> (ticks)
+ * - swap-out-after <uint32> (ticks)
+ * - dispatch-policy <string> ("fifo" or "affinity")
+ * - dispatch-window <uint32>
+ * - prepage-pages <uint32>
+ * - oom-killer <string> ("off", "rss", "youngest" or "faults")
+ * - oom-fault-threshold <uint32> (faults per window)
+ * - oom-window <uint32> (ticks)
+ * - replacement-scope <string> ("global" or "local")
+ * - max-rss-per-proc <uint32> (bytes)
+ * - shared-code <string> ("off" or "on")
+ * - ksm-scan-interval <uint32> (ticks)
+ * - zswap-pool-percent <uint32> (percent of max-overall-mem)
+ * - zswap-latency <uint32> (ticks)
+ * - huge-page-frames <uint32> (base frames per huge frame)
+ * - huge-promote-threshold <uint32> (resident pages per region)
+ * - ghost-policies <string> ("off" or "on")
+ * - max-pinned-frames <uint32> (frames)
+ * - auto-pin <string> ("off" or "on")
+ * - code-segment-base <hex> (virtual address, "0x" prefix optional)
+ * - address-model <string> ("uniform", "sequential", "zipf" or "phased")
+ * - address-stride <uint32> (bytes)
+ * - zipf-skew <double> (Zipf exponent)
+ * - phase-length <uint32> (addresses per phase)
+ * - phase-pages <uint32> (pages per phase)
  */
 void initializeConfig(ifstream& file) {
     string key;
@@ -208,6 +265,38 @@ void initializeConfig(ifstream& file) {
         else if (key == "min-mem-per-proc") file >> config.minMemPerProc;
         else if (key == "max-mem-per-proc") file >> config.maxMemPerProc;
         else if (key == "replacement-policy") file >> config.replacementPolicy;
+        else if (key == "reclaim-low-watermark")  file >> config.reclaimLowWatermark;
+        else if (key == "reclaim-high-watermark") file >> config.reclaimHighWatermark;
+        else if (key == "page-fault-latency")     file >> config.pageFaultLatency;
+        else if (key == "disk-scheduler")         file >> config.diskScheduler;
+        else if (key == "disk-seek-ticks")        file >> config.diskSeekTicks;
+        else if (key == "disk-transfer-ticks")    file >> config.diskTransferTicks;
+        else if (key == "load-control")           file >> config.loadControl;
+        else if (key == "working-set-window")     file >> config.workingSetWindow;
+        else if (key == "swap-out-after")         file >> config.swapOutAfter;
+        else if (key == "dispatch-policy")        file >> config.dispatchPolicy;
+        else if (key == "dispatch-window")        file >> config.dispatchWindow;
+        else if (key == "prepage-pages")          file >> config.prepagePages;
+        else if (key == "oom-killer")             file >> config.oomKiller;
+        else if (key == "oom-fault-threshold")    file >> config.oomFaultThreshold;
+        else if (key == "oom-window")             file >> config.oomWindow;
+        else if (key == "replacement-scope")      file >> config.replacementScope;
+        else if (key == "max-rss-per-proc")       file >> config.maxRssPerProc;
+        else if (key == "shared-code")            file >> config.sharedCode;
+        else if (key == "ksm-scan-interval")      file >> config.ksmScanInterval;
+        else if (key == "zswap-pool-percent")     file >> config.zswapPoolPercent;
+        else if (key == "zswap-latency")          file >> config.zswapLatency;
+        else if (key == "huge-page-frames")       file >> config.hugePageFrames;
+        else if (key == "huge-promote-threshold") file >> config.hugePromoteThreshold;
+        else if (key == "ghost-policies")         file >> config.ghostPolicies;
+        else if (key == "max-pinned-frames")      file >> config.maxPinnedFrames;
+        else if (key == "auto-pin")               file >> config.autoPin;
+        else if (key == "code-segment-base")      file >> hex >> config.codeSegmentBase >> dec;
+        else if (key == "address-model")          file >> config.addressModel;
+        else if (key == "address-stride")         file >> config.addressStride;
+        else if (key == "zipf-skew")              file >> config.zipfSkew;
+        else if (key == "phase-length")           file >> config.phaseLength;
+        else if (key == "phase-pages")            file >> config.phasePages;
         else {
             // Unknown key - skip value
             string dummy;
@@ -216,6 +305,18 @@ void initializeConfig(ifstream& file) {
     }
 }
 
+/**
+ * @brief Check if a number is a power of two
+ * @param x Number to check
+ * @return true if x is a power of 2, false otherwise
+ * 
+ * Uses bit manipulation: powers of 2 have only one bit set.
+ * Example: 8 (1000) & 7 (0111) = 0
+ */
+bool isPowerOfTwo(uint64_t x) {
+    return x && !(x & (x - 1));
+}
+
 /**
  * @brief Validate loaded configuration values
  * @param cfg Configuration to validate
@@ -227,6 +328,31 @@ void initializeConfig(ifstream& file) {
  * - quantumCycles >= 1
  * - batchProcessFreq >= 1
  * - minIns >= 1 and maxIns >= minIns
+ * - memPerFrame > 0 and at most INT_MAX frames of physical memory
+ * - minMemPerProc <= maxMemPerProc < 4 GB (32-bit process address space)
+ * - reclaimHighWatermark >= reclaimLowWatermark
+ * - diskScheduler is "none", "fcfs", "sstf" or "scan"
+ * - loadControl is "off" or "ws", workingSetWindow >= 1
+ * - dispatchPolicy is "fifo" or "affinity", dispatchWindow >= 1
+ * - oomKiller is "off", "rss", "youngest" or "faults", oomWindow >= 1
+ * - replacementScope is "global" or "local"
+ * - sharedCode is "off" or "on"
+ * - zswapPoolPercent <= 100 and the pool (rounded up to frames, taken
+ *   out of the frame pool) leaves at least one frame for pages
+ * - hugePageFrames is 0 or a power of 2 >= 2 (at most the page frame
+ *   count), with 1 <= hugePromoteThreshold <= hugePageFrames
+ * - ghostPolicies is "off" or "on"
+ * - maxPinnedFrames is below the page frame count (a victim always exists)
+ * - reclaimHighWatermark is below the page frame count (the reclaimer
+ *   never empties memory, so a faulting process keeps its page)
+ * - autoPin is "off" or "on" ("on" needs maxPinnedFrames > 0)
+ * - codeSegmentBase is page aligned, leaves room for the symbol-table
+ *   page(s) above every data address (max-mem-per-proc and the 64 KB
+ *   screen limit), and the largest program (maxIns or a 50-instruction
+ *   screen -c program, MAX_ENCODED_INSTRUCTION_BYTES each) still ends
+ *   inside the 32-bit address space
+ * - addressModel is "uniform", "sequential", "zipf" or "phased", with
+ *   addressStride, phaseLength and phasePages >= 1 and zipfSkew > 0
  */
 
 bool isValidConfig(const Config& cfg) {
@@ -235,19 +361,85 @@ bool isValidConfig(const Config& cfg) {
     if (cfg.quantumCycles < 1) return false;
     if (cfg.batchProcessFreq < 1) return false;
     if (cfg.minIns < 1 || cfg.maxIns < cfg.minIns) return false;
+    if (cfg.memPerFrame == 0 || cfg.maxOverallMem / cfg.memPerFrame > INT_MAX) return false;
+    if (cfg.minMemPerProc > cfg.maxMemPerProc || cfg.maxMemPerProc > UINT32_MAX) return false;
+    if (cfg.reclaimHighWatermark < cfg.reclaimLowWatermark) return false;
+    if (cfg.diskScheduler != "none" && cfg.diskScheduler != "fcfs" &&
+        cfg.diskScheduler != "sstf" && cfg.diskScheduler != "scan") return false;
+    if (cfg.loadControl != "off" && cfg.loadControl != "ws") return false;
+    if (cfg.workingSetWindow < 1) return false;
+    if (cfg.dispatchPolicy != "fifo" && cfg.dispatchPolicy != "affinity") return false;
+    if (cfg.dispatchWindow < 1) return false;
+    if (cfg.oomKiller != "off" && cfg.oomKiller != "rss" &&
+        cfg.oomKiller != "youngest" && cfg.oomKiller != "faults") return false;
+    if (cfg.oomWindow < 1) return false;
+    if (cfg.replacementScope != "global" && cfg.replacementScope != "local") return false;
+    if (cfg.sharedCode != "off" && cfg.sharedCode != "on") return false;
+    if (cfg.zswapPoolPercent > 100) return false;
+    // Frames left for pages once the compressed pool has its share of RAM
+    uint64_t poolFrames = MemoryManager::zswapReservedFrames(cfg);
+    if (poolFrames >= cfg.maxOverallMem / cfg.memPerFrame) return false;
+    uint64_t pageFrames = cfg.maxOverallMem / cfg.memPerFrame - poolFrames;
+    if (cfg.hugePageFrames != 0) {
+        if (cfg.hugePageFrames < 2 || !isPowerOfTwo(cfg.hugePageFrames)) return false;
+        if (cfg.hugePageFrames > pageFrames) return false;
+        if (cfg.hugePromoteThreshold < 1 || cfg.hugePromoteThreshold > cfg.hugePageFrames) return false;
+    }
+    if (cfg.ghostPolicies != "off" && cfg.ghostPolicies != "on") return false;
+    if (cfg.maxPinnedFrames >= pageFrames) return false;
+    if (cfg.reclaimHighWatermark >= pageFrames) return false;
+    if (cfg.autoPin != "off" && cfg.autoPin != "on") return false;
+    if (cfg.autoPin == "on" && cfg.maxPinnedFrames == 0) return false;
+    if (cfg.codeSegmentBase % cfg.memPerFrame != 0) return false;
+    uint64_t symbolTableSpan = (SYMBOL_TABLE_BYTES + cfg.memPerFrame - 1) / cfg.memPerFrame * cfg.memPerFrame;
+    if (cfg.codeSegmentBase < std::max<uint64_t>(cfg.maxMemPerProc, 65536) + symbolTableSpan) return false;
+    uint64_t maxCodeBytes = std::max<uint64_t>(cfg.maxIns, MAX_SCREEN_C_INSTRUCTIONS) * MAX_ENCODED_INSTRUCTION_BYTES;
+    if (cfg.codeSegmentBase + maxCodeBytes > UINT32_MAX) return false;
+    if (cfg.addressModel != "uniform" && cfg.addressModel != "sequential" &&
+        cfg.addressModel != "zipf" && cfg.addressModel != "phased") return false;
+    if (cfg.addressStride < 1 || cfg.phaseLength < 1 || cfg.phasePages < 1) return false;
+    if (!(cfg.zipfSkew > 0)) return false;
     return true;
 }
 
 /**
- * @brief Check if a number is a power of two
- * @param x Number to check
- * @return true if x is a power of 2, false otherwise
- * 
- * Uses bit manipulation: powers of 2 have only one bit set.
- * Example: 8 (1000) & 7 (0111) = 0
+ * @brief Parse the optional max-RSS operand of screen -s / screen -c
+ * @param token Operand text (decimal bytes)
+ * @param out Parsed resident-set cap in bytes (0 = unlimited)
+ * @return false if the token is not a plain decimal number
  */
-bool isPowerOfTwo(uint32_t x) {
-    return x && !(x & (x - 1));
+bool parseMaxRss(const string& token, uint32_t& out) {
+    if (token.empty()) return false;
+    for (char c : token) {
+        if (!isdigit(static_cast<unsigned char>(c))) return false;
+    }
+
+    try {
+        out = static_cast<uint32_t>(stoul(token));
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+/**
+ * @brief Parse a plain decimal count or size operand
+ * @param token Operand text
+ * @param out Parsed value
+ * @return false if the token is not a plain decimal number or overflows
+ */
+bool parseCount(const string& token, uint64_t& out) {
+    if (token.empty()) return false;
+    for (char c : token) {
+        if (!isdigit(static_cast<unsigned char>(c))) return false;
+    }
+
+    try {
+        out = stoull(token);
+        return true;
+    } catch (...) {
+        return false;
+    }
 }
 
 // ============================================================================
@@ -259,7 +451,7 @@ void handleScreenCommand(const string& param) {
 
     // ------------------------------------------------------------------------
     // screen -s (auto-generated instructions)
-    // Syntax: screen -s <name> <memsize>
+    // Syntax: screen -s <name> <memsize> [max-rss]
     // ------------------------------------------------------------------------
     if(sub == "-s") {
         string pname;
@@ -273,8 +465,17 @@ void handleScreenCommand(const string& param) {
             return;
         }
 
+        // Optional resident-set cap (defaults to max-rss-per-proc)
+        uint32_t maxRss = config.maxRssPerProc;
+        string rssToken;
+        if(ss >> rssToken && !parseMaxRss(rssToken, maxRss)) {
+            cout << "invalid memory allocation\n";
+            return;
+        }
+
         int pid = next_process_id++;
         Process p(pid, pname, 5, memsize);
+        p.max_rss = maxRss;
         p.instructions = {
             { "DECLARE", { "x", "0" } },
             { "ADD", { "x", "x", "1" } },
@@ -282,19 +483,19 @@ void handleScreenCommand(const string& param) {
         };
 
         // Ask MemoryManager to create page table for this process
-        if(!MemoryManager::getInstance().allocateMemory(pid, memsize)) {
+        if(!MemoryManager::getInstance().allocateMemory(pid, memsize, maxRss)) {
             cout << "memory allocation failed\n";
             return;
         }
 
         lock_guard<mutex> lock(queue_mutex);
-        ready_queue.push_back(move(p));
+        admit_process(move(p));
         cout << "Process " << pname << " created.\n";
     }
 
     // ------------------------------------------------------------------------
     // screen -c (user-defined instructions)
-    // Syntax: screen -c <name> <memsize> "<instructions>"
+    // Syntax: screen -c <name> <memsize> [max-rss] "<instructions>"
     // ------------------------------------------------------------------------
     else if(sub == "-c") {
         string pname;
@@ -312,6 +513,19 @@ void handleScreenCommand(const string& param) {
         getline(ss, code);
         trimLeadingSpaces(code);
 
+        // Optional resident-set cap before the quoted instructions
+        uint32_t maxRss = config.maxRssPerProc;
+        if(!code.empty() && code.front() != '"') {
+            size_t end = code.find_first_of(" \t");
+            string rssToken = code.substr(0, end);
+            if(!parseMaxRss(rssToken, maxRss)) {
+                cout << "invalid memory allocation\n";
+                return;
+            }
+            code = (end == string::npos) ? "" : code.substr(end);
+            trimLeadingSpaces(code);
+        }
+
         if(code.size() < 2 || code.front() != '"' || code.back() != '"') {
             cout << "invalid command\n";
             return;
@@ -327,7 +541,7 @@ void handleScreenCommand(const string& param) {
             if(!temp.empty()) lines.push_back(temp);
         }
 
-        if(lines.empty() || lines.size() > 50) {
+        if(lines.empty() || lines.size() > MAX_SCREEN_C_INSTRUCTIONS) {
             cout << "invalid command\n";
             return;
         }
@@ -359,6 +573,11 @@ void handleScreenCommand(const string& param) {
             else if(op == "SLEEP") valid = (ins.args.size() == 1);
             else if(op == "FOR") valid = (ins.args.size() == 2);
             else if(op == "READ" || op == "WRITE") valid = (ins.args.size() == 2);
+            else if(op == "FORK") valid = ins.args.empty();
+            else if(op == "PIN") valid = (ins.args.size() == 1);
+            else if(op == "MMAP") valid = (ins.args.size() == 3);
+            else if(op == "MALLOC") valid = (ins.args.size() == 2);
+            else if(op == "FREE") valid = (ins.args.size() == 1);
             else if(op == "PRINT") valid = true;
             else valid = false;
 
@@ -375,15 +594,16 @@ void handleScreenCommand(const string& param) {
             static_cast<uint32_t>(instructions.size()),
             memsize);
         p.instructions = move(instructions);
+        p.max_rss = maxRss;
 
         // Initialize memory for the process
-        if(!MemoryManager::getInstance().allocateMemory(pid, memsize)) {
+        if(!MemoryManager::getInstance().allocateMemory(pid, memsize, maxRss)) {
             cout << "memory allocation failed\n";
             return;
         }
 
         lock_guard<mutex> lock(queue_mutex);
-        ready_queue.push_back(move(p));
+        admit_process(move(p));
 
         cout << "Process " << pname << " created.\n";
     }
@@ -413,12 +633,34 @@ void handleScreenCommand(const string& param) {
                 if(p->state == ProcessState::READY) cout << "READY\n";
                 else if(p->state == ProcessState::RUNNING) cout << "RUNNING\n";
                 else if(p->state == ProcessState::SLEEPING) cout << "SLEEPING\n";
+                else if(p->state == ProcessState::BLOCKED) cout << "BLOCKED (page-in)\n";
+                else if(p->state == ProcessState::SUSPENDED) cout << "SUSPENDED (load control)\n";
+                else if(p->state == ProcessState::SWAPPED) cout << "SWAPPED\n";
                 else if(p->state == ProcessState::FINISHED) cout << "FINISHED\n";
                 else if(p->state == ProcessState::MEMORY_VIOLATED) cout << "MEMORY-VIOLATED\n";
+                else if(p->state == ProcessState::OOM_KILLED) cout << "OOM-KILLED\n";
 
                 cout << "Instruction: " << p->current_instruction
                     << "/" << p->total_instructions << "\n";
 
+                if(!p->code_offsets.empty()) {
+                    cout << "Code: " << p->code_offsets.back() << " bytes at 0x"
+                        << hex << uppercase << p->code_base << dec << nouppercase << "\n";
+                    cout << "Symbol table: " << p->symbol_table_bytes_used << "/" << SYMBOL_TABLE_BYTES
+                        << " bytes at 0x" << hex << uppercase << p->symbol_table_base << dec << nouppercase << "\n";
+                }
+
+                cout << "RSS limit: ";
+                if(p->max_rss == 0) cout << "unlimited\n";
+                else cout << p->max_rss << " bytes (" << config.replacementScope << " replacement)\n";
+
+                if(p->heap.isConfigured()) {
+                    cout << "Heap: " << p->heap.getLiveBytes() << " bytes in "
+                        << p->heap.getLiveBlocks() << " blocks over " << p->heap.getPagesInUse()
+                        << " pages (" << fixed << setprecision(1)
+                        << p->heap.getFragmentation() * 100.0 << "% fragmented)\n";
+                }
+
                 cout << "\nVariables:\n";
                 for(auto& kv : p->memory)
                     cout << "  " << kv.first << " = " << kv.second << "\n";
@@ -497,7 +739,7 @@ static std::string formatBytes(size_t bytes) {
  * @brief Handle top-level process-smi command
  *
  * Prints:
- * - Memory summary (total/used/free)
+ * - Memory summary (total/used/free, swapped-out processes)
  * - CPU utilization
  * - Per-process listing with PID, name, VM size, RSS (resident) bytes
  */
@@ -518,7 +760,18 @@ void handleProcessSMI() {
     cout << "Memory Summary:\n";
     cout << "  Total: " << formatBytes(totalMem) << "\n";
     cout << "  Used : " << formatBytes(usedMem) << "\n";
-    cout << "  Free : " << formatBytes(freeMem) << "\n\n";
+    cout << "  Free : " << formatBytes(freeMem) << "\n";
+
+    uint64_t batchSwapIns = mm.getNumProcessSwapIns();
+    size_t swappedProcs = 0;
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        swappedProcs = swapped_queue.size();
+    }
+    cout << "  Swapped processes: " << swappedProcs << " (avg batch swap-in "
+        << fixed << setprecision(2)
+        << (batchSwapIns ? static_cast<double>(mm.getBatchSwapInTicks()) / batchSwapIns : 0.0)
+        << " ticks)\n\n";
 
     cout << left << setw(6) << "PID"
         << setw(20) << "NAME"
@@ -545,6 +798,9 @@ void handleProcessSMI() {
         if(opt.has_value()) print_proc(opt.value());
     }
     for(const auto& p : sleeping_queue) print_proc(p);
+    for(const auto& p : blocked_queue) print_proc(p);
+    for(const auto& p : suspended_queue) print_proc(p);
+    for(const auto& p : swapped_queue) print_proc(p);
     for(const auto& p : finished_queue) print_proc(p);
 
     cout << "\n";
@@ -561,11 +817,32 @@ void handleProcessSMI() {
  * - Total memory (bytes)
  * - Used memory (bytes)
  * - Free memory (bytes)
+ * - Frame metadata held on the host (chunks allocated on first use)
  * - Idle cpu ticks
  * - Active cpu ticks
  * - Total cpu ticks (sum of active + idle)
  * - Num paged in
  * - Num paged out
+ * - Page faults and faults per dispatch
+ * - Local replacements (faults at a process's RSS cap)
+ * - Shared code segments (if shared-code is on)
+ * - Forks, copy-on-write faults and shared frames
+ * - File mappings, pages read from files and clean file pages dropped
+ * - Frames given back when FREE empties heap pages
+ * - Same-page merging (if ksm-scan-interval > 0)
+ * - Compressed swap pool (if zswap-pool-percent > 0)
+ * - Huge frames, promotions/demotions, faults avoided and ticks spent
+ *   filling promoted regions (if huge-page-frames > 0)
+ * - Shadow fault counts of every replacement policy (if ghost-policies is on)
+ * - Pinned frames against the cap and rejected pins (if max-pinned-frames > 0)
+ * - Prepaging: pages prefetched, hits, waste, ticks stalled on batch reads
+ * - Reclaimer runs / pages reclaimed / direct reclaims
+ * - Pending page-ins (processes blocked on a fault)
+ * - Paging disk queue depth, completed requests, average service/response ticks
+ * - Load control: current/target multiprogramming level, suspended processes
+ * - Medium-term swapping: swapped processes, swap-outs, batch swap-in pages/cost
+ * - OOM killer: kills and the latest victim
+ * - Page-reference trace: file and records written
  */
 void handleVMStat() {
     auto& mm = MemoryManager::getInstance();
@@ -581,18 +858,357 @@ void handleVMStat() {
     uint64_t pagedIn = mm.getNumPagedIn();
     uint64_t pagedOut = mm.getNumPagedOut();
 
+    uint64_t reclaimRuns = mm.getNumReclaimRuns();
+    uint64_t pagesReclaimed = mm.getNumPagesReclaimed();
+    uint64_t directReclaims = mm.getNumDirectReclaims();
+    size_t pendingPageIns = mm.getNumPendingPageIns();
+
+    size_t diskDepth = mm.getDiskQueueDepth();
+    size_t diskMaxDepth = mm.getDiskMaxQueueDepth();
+    uint64_t diskCompleted = mm.getDiskNumCompleted();
+    double diskService = mm.getDiskAvgServiceTicks();
+    double diskResponse = mm.getDiskAvgResponseTicks();
+
     cout << "VMSTAT\n";
     cout << "------\n";
     cout << "Total memory   : " << totalMem << " bytes (" << formatBytes(totalMem) << ")\n";
     cout << "Used memory    : " << usedMem << " bytes (" << formatBytes(usedMem) << ")\n";
-    cout << "Free memory    : " << freeMem << " bytes (" << formatBytes(freeMem) << ")\n\n";
+    cout << "Free memory    : " << freeMem << " bytes (" << formatBytes(freeMem) << ")\n";
+    cout << "Frame metadata : " << formatBytes(mm.getFrameMetadataBytes())
+        << " for " << mm.getTotalFrames() << " frames\n\n";
 
     cout << "Idle cpu ticks : " << idleTicks << "\n";
     cout << "Active cpu ticks: " << activeTicks << "\n";
     cout << "Total cpu ticks : " << totalCoreTicks << "\n\n";
 
     cout << "Num paged in   : " << pagedIn << "\n";
-    cout << "Num paged out  : " << pagedOut << "\n\n";
+    cout << "Num paged out  : " << pagedOut << "\n";
+
+    uint64_t faults = mm.getNumPageFaults();
+    uint64_t dispatches = total_dispatches.load();
+    cout << "Page faults    : " << faults << " (" << fixed << setprecision(2)
+        << (dispatches ? static_cast<double>(faults) / dispatches : 0.0)
+        << " per dispatch, " << config.dispatchPolicy << ")\n";
+    cout << "Local replacements: " << mm.getNumLocalReplacements()
+        << " (" << config.replacementScope << " scope)\n";
+    cout << "Forks          : " << mm.getNumForks()
+        << " (COW faults " << mm.getNumCowFaults()
+        << ", shared frames " << mm.getNumSharedFrames() << ")\n";
+    cout << "File mappings  : " << mm.getNumFileMappings()
+        << " (" << mm.getNumFilePageIns() << " pages read from files, "
+        << mm.getNumFileDrops() << " clean pages dropped)\n";
+    cout << "Heap pages freed: " << mm.getNumDiscardedPages() << " frames given back by FREE\n";
+    if(config.ksmScanInterval > 0) {
+        cout << "Same-page merge: " << mm.getNumMergedPages() << " pages merged in "
+            << mm.getNumMergeScans() << " scans (" << mm.getNumSharedFrames()
+            << " shared frames, " << mm.getNumFramesSaved() << " frames saved)\n";
+    }
+    if(config.hugePageFrames > 0) {
+        cout << "Huge pages     : " << mm.getNumHugePages() << " mapped ("
+            << config.hugePageFrames << " frames each), "
+            << mm.getNumHugePromotions() << " promotions, "
+            << mm.getNumHugeDemotions() << " demotions, "
+            << mm.getNumHugeFaultsAvoided() << " faults avoided, "
+            << mm.getHugeFillTicks() << " fill ticks\n";
+    }
+    if(config.zswapPoolPercent > 0) {
+        cout << "Zswap pool     : " << mm.getZswapPoolBytes() << "/" << mm.getZswapPoolCapacity()
+            << " bytes in " << MemoryManager::zswapReservedFrames(config) << " reserved frames, " << mm.getZswapStoredPages() << " pages (ratio "
+            << fixed << setprecision(2) << mm.getZswapCompressionRatio() << ":1)\n";
+        cout << "Zswap traffic  : " << mm.getZswapHits() << " hits, "
+            << mm.getZswapEvictions() << " evictions to disk, "
+            << mm.getZswapRejects() << " rejected\n";
+    }
+    if(config.ghostPolicies == "on") {
+        // What each policy would have faulted on the same references
+        uint64_t fifoFaults = mm.getGhostFaults("fifo");
+        uint64_t lruFaults = mm.getGhostFaults("lru");
+        cout << "Shadow faults  : fifo " << fifoFaults << ", lru " << lruFaults
+            << " over " << mm.getGhostReferences() << " references (live "
+            << config.replacementPolicy << ": " << faults << ", best "
+            << (lruFaults < fifoFaults ? "lru" : fifoFaults < lruFaults ? "fifo" : "tie") << ")\n";
+    }
+    if(config.maxPinnedFrames > 0) {
+        cout << "Pinned frames  : " << mm.getNumPinnedFrames() << "/" << config.maxPinnedFrames
+            << " (auto-pin " << config.autoPin << ", " << mm.getNumPinRejects() << " rejected)\n";
+    }
+    if(config.sharedCode == "on") {
+        cout << "Code segments  : " << mm.getNumCodeSegments()
+            << " (" << mm.getSharedCodeFrames() << " frames resident, "
+            << mm.getNumCodeShares() << " shared attaches)\n";
+    }
+    cout << "Prepaged pages : " << mm.getNumPrepagedPages() << " (hits "
+        << mm.getNumPrepageHits() << ", wasted " << mm.getNumPrepageWaste() << ", "
+        << mm.getPrepageTicks() << " ticks stalled)\n\n";
+
+    cout << "Reclaimer runs : " << reclaimRuns << "\n";
+    cout << "Pages reclaimed: " << pagesReclaimed << "\n";
+    cout << "Direct reclaims: " << directReclaims << "\n";
+    cout << "Pending page-ins: " << pendingPageIns << "\n\n";
+
+    if (config.diskScheduler != "none") {
+        cout << "Disk scheduler : " << config.diskScheduler << "\n";
+        cout << "Disk queue depth: " << diskDepth << " (max " << diskMaxDepth << ")\n";
+        cout << "Disk requests  : " << diskCompleted << "\n";
+        cout << "Avg disk service : " << fixed << setprecision(2) << diskService << " ticks\n";
+        cout << "Avg disk response: " << fixed << setprecision(2) << diskResponse << " ticks\n\n";
+    }
+
+    size_t suspended = 0;
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        suspended = suspended_queue.size();
+    }
+    cout << "Load control   : " << config.loadControl << "\n";
+    cout << "MPL current/target: " << current_mpl.load() << " / " << target_mpl.load() << "\n";
+    cout << "Suspended procs: " << suspended << " (" << total_suspensions.load() << " suspensions)\n\n";
+
+    size_t swappedProcs = 0;
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        swappedProcs = swapped_queue.size();
+    }
+    uint64_t swapIns = mm.getNumProcessSwapIns();
+    cout << "Swapped procs  : " << swappedProcs << "\n";
+    cout << "Process swap-outs: " << mm.getNumProcessSwapOuts() << "\n";
+    cout << "Batch swap-ins : " << swapIns << " (" << mm.getNumBatchSwapInPages() << " pages, "
+        << mm.getBatchSwapInTicks() << " ticks, avg " << fixed << setprecision(2)
+        << (swapIns ? static_cast<double>(mm.getBatchSwapInTicks()) / swapIns : 0.0)
+        << " ticks)\n\n";
+
+    string lastVictim;
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        lastVictim = last_oom_victim;
+    }
+    cout << "OOM killer     : " << config.oomKiller << " (" << total_oom_kills.load() << " kills)\n";
+    if (!lastVictim.empty()) cout << "Last OOM kill  : " << lastVictim << "\n";
+
+    if (mm.isTracing()) {
+        cout << "Page trace     : recording to " << mm.getTracePath()
+            << " (" << mm.getTraceRecordCount() << " records)\n";
+    } else {
+        cout << "Page trace     : off\n";
+    }
+    cout << "\n";
+}
+
+// ============================================================================
+// Page Trace Commands
+// ============================================================================
+
+/**
+ * @brief Start recording page references
+ * @param args Trace file name
+ *
+ * Syntax: trace-start <file>. A trace already running is closed first.
+ */
+void handleTraceStart(const string& args) {
+    string path;
+    istringstream ss(args);
+    if (!(ss >> path)) {
+        cout << "Usage: trace-start <file>\n";
+        return;
+    }
+
+    if (!MemoryManager::getInstance().startTrace(path)) {
+        cout << "Cannot open trace file " << path << "\n";
+        return;
+    }
+    cout << "Recording page references to " << path << "\n";
+}
+
+/**
+ * @brief Stop recording and report the number of records written
+ */
+void handleTraceStop() {
+    auto& mm = MemoryManager::getInstance();
+    if (!mm.isTracing()) {
+        cout << "No trace is being recorded.\n";
+        return;
+    }
+
+    uint64_t records = mm.stopTrace();
+    cout << "Trace " << mm.getTracePath() << " closed (" << records << " records)\n";
+}
+
+/**
+ * @brief Replay a recorded trace against other policies and memory sizes
+ * @param args <file> [fifo|lru|both] [mem-per-frame] [mem-size...]
+ *
+ * Defaults: the configured replacement policy, the trace's page size, and
+ * memory sizes doubling from one frame until every distinct page of the
+ * trace fits. All (policy, size) pairs are replayed in parallel on host
+ * threads and printed as a miss-ratio curve with replay throughput.
+ */
+void handleTraceReplay(const string& args) {
+    const string usage = "Usage: trace-replay <file> [fifo|lru|both] [mem-per-frame] [mem-size...]\n";
+    istringstream ss(args);
+    string path;
+    if (!(ss >> path)) {
+        cout << usage;
+        return;
+    }
+
+    vector<PageTraceRecord> references;
+    uint64_t tracePageSize = 0;
+    if (!loadTraceReferences(path, references, tracePageSize) || tracePageSize == 0) {
+        cout << "Cannot read trace file " << path << "\n";
+        return;
+    }
+    if (references.empty()) {
+        cout << "Trace " << path << " has no references.\n";
+        return;
+    }
+
+    string policy = config.replacementPolicy;
+    uint64_t memPerFrame = tracePageSize;
+    vector<uint64_t> sizes;
+    string token;
+    if (ss >> token) policy = token;
+    if (ss >> token && !parseCount(token, memPerFrame)) memPerFrame = 0;
+    while (ss >> token) {
+        uint64_t size = 0;
+        if (!parseCount(token, size)) {
+            cout << usage;
+            return;
+        }
+        sizes.push_back(size);
+    }
+
+    if ((policy != "fifo" && policy != "lru" && policy != "both") ||
+        memPerFrame == 0 || !isPowerOfTwo(memPerFrame)) {
+        cout << usage;
+        return;
+    }
+    for (uint64_t size : sizes) {
+        if (size < memPerFrame || size / memPerFrame > INT_MAX) {
+            cout << "Invalid memory size " << size << " for " << memPerFrame << "-byte frames\n";
+            return;
+        }
+    }
+
+    // Default sweep: 1, 2, 4, ... frames until the whole footprint fits
+    size_t distinct = countDistinctPages(references);
+    if (sizes.empty()) {
+        for (uint64_t frames = 1; ; frames *= 2) {
+            sizes.push_back(frames * memPerFrame);
+            if (frames >= distinct) break;
+        }
+    }
+
+    vector<string> policies = (policy == "both") ? vector<string>{ "fifo", "lru" }
+                                                 : vector<string>{ policy };
+    vector<ReplayJob> jobs;
+    for (const auto& name : policies) {
+        for (uint64_t size : sizes) {
+            jobs.push_back({ name, memPerFrame, size });
+        }
+    }
+
+    unsigned threads = min<unsigned>(max(1u, thread::hardware_concurrency()),
+                                     static_cast<unsigned>(jobs.size()));
+    auto start = chrono::steady_clock::now();
+    vector<ReplayResult> results = replaySweep(references, tracePageSize, config, jobs, threads);
+    chrono::duration<double> wall = chrono::steady_clock::now() - start;
+
+    cout << "\nReplaying " << path << ": " << references.size() << " references, "
+        << distinct << " distinct pages, " << tracePageSize << "-byte pages, "
+        << threads << " threads\n";
+    cout << left << setw(8) << "Policy" << right << setw(12) << "Memory" << setw(10) << "Frames"
+        << setw(10) << "Faults" << setw(11) << "Hit ratio" << setw(12) << "Mrefs/s" << "\n";
+
+    double replaySeconds = 0.0;
+    for (const auto& r : results) {
+        replaySeconds += r.seconds;
+        cout << left << setw(8) << r.job.policy << right << setw(12) << r.job.memBytes
+            << setw(10) << r.frames << setw(10) << r.faults
+            << fixed << setprecision(4) << setw(11) << r.hitRatio()
+            << setprecision(2) << setw(12) << r.referencesPerSec() / 1e6 << "\n";
+    }
+    cout << "Sweep wall-clock: " << setprecision(3) << wall.count() * 1000 << " ms ("
+        << replaySeconds * 1000 << " ms of replay across threads)\n\n" << defaultfloat;
+}
+
+// ============================================================================
+// Frame Table Benchmark
+// ============================================================================
+
+/**
+ * @brief Time the frame-table scan kernels, scalar against AVX2
+ * @param args Optional frame count (default 1048576)
+ *
+ * Builds a private FrameTable (the live memory manager is untouched) with
+ * one frame in eight free and the rest spread over 64 owners with random
+ * ticks, then reports microseconds per million frames for the global
+ * victim search, a per-owner victim search and the used-frame count.
+ * The AVX2 column is only shown when the CPU supports AVX2.
+ */
+void handleFrameBench(const string& args) {
+    size_t numFrames = 1 << 20;
+    string token;
+    istringstream ss(args);
+    if (ss >> token) {
+        uint64_t parsed = 0;
+        if (!parseCount(token, parsed) || parsed == 0 || parsed > INT_MAX) {
+            cout << "Usage: frame-bench [frames]\n";
+            return;
+        }
+        numFrames = static_cast<size_t>(parsed);
+    }
+
+    FrameTable table;
+    table.reset(numFrames);
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i < numFrames; ++i) {
+        if (i % 8 == 7) {
+            table.owner(i);  // Materialize, leave free
+            continue;
+        }
+        table.owner(i) = static_cast<int32_t>(i % 64);
+        table.markUsed(i);
+        table.allocatedTick(i) = rng() % 1000000;
+        table.lastAccessedTick(i) = rng() % 1000000;
+    }
+
+    const int rounds = 20;
+    struct Result { double micros; size_t value; };
+    auto timeKernel = [&](auto&& kernel) {
+        size_t value = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) value = kernel();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return Result{ elapsed.count() / rounds * 1e6 / numFrames, value };
+    };
+
+    const pair<string, std::function<size_t()>> kernels[] = {
+        { "victim (lru)",   [&] { return static_cast<size_t>(table.findVictim(true)); } },
+        { "victim (owner)", [&] { return static_cast<size_t>(table.findVictim(false, 5)); } },
+        { "used count",     [&] { return table.countUsed(); } },
+    };
+
+    bool simd = FrameTable::simdAvailable();
+    cout << "\nFrame scan benchmark: " << numFrames << " frames, " << rounds << " rounds\n";
+    cout << left << setw(16) << "Kernel" << right << setw(14) << "scalar us/M";
+    if (simd) cout << setw(14) << "avx2 us/M" << setw(10) << "speedup";
+    cout << "\n";
+
+    cout << fixed << setprecision(1);
+    for (const auto& [name, kernel] : kernels) {
+        table.setSimd(false);
+        Result scalar = timeKernel(kernel);
+        cout << left << setw(16) << name << right << setw(14) << scalar.micros;
+
+        if (simd) {
+            table.setSimd(true);
+            Result vector = timeKernel(kernel);
+            cout << setw(14) << vector.micros << setw(9) << scalar.micros / vector.micros << "x";
+            if (vector.value != scalar.value) cout << "  (MISMATCH)";
+        }
+        cout << "\n";
+    }
+    if (!simd) cout << "AVX2 not supported on this CPU (scalar kernels only)\n";
+    cout << defaultfloat << "\n";
 }
 
 // ============================================================================
@@ -623,6 +1239,7 @@ void handleCommand(const string& cmd, const string& rest, bool& running) {
         }
 
         MemoryManager::getInstance().initialize();
+        MemoryManager::getInstance().startReclaimer();
 
         isInitialized = true;
         cpu_cores.resize(config.numCPU);
@@ -639,6 +1256,14 @@ void handleCommand(const string& cmd, const string& rest, bool& running) {
         handleProcessSMI();
     } else if(cmd == "vmstat") {
         handleVMStat();
+    } else if (cmd == "frame-bench") {
+        handleFrameBench(rest);
+    } else if (cmd == "trace-start") {
+        handleTraceStart(rest);
+    } else if (cmd == "trace-stop") {
+        handleTraceStop();
+    } else if (cmd == "trace-replay") {
+        handleTraceReplay(rest);
     } else cout << "Unknown command\n";
 }
 
@@ -661,5 +1286,8 @@ int main() {
         handleCommand(cmd, rest, running);
     }
 
+    // Flush a trace left running
+    MemoryManager::getInstance().stopTrace();
+
     return 0;
 }
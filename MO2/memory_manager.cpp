@@ -3,7 +3,8 @@
  * @brief Implementation of paging-based memory management
  * 
  * Handles demand paging, page replacement (FIFO/LRU), and backing store simulation.
- * Integrates with scheduler via global_cpu_tick for timestamp-based replacement.
+ * Integrates with scheduler via global_cpu_tick (or the clock given to a
+ * standalone instance) for timestamp-based replacement.
  */
 
 #include "memory_manager.h"
@@ -11,34 +12,123 @@
 #include <algorithm>
 #include <climits>
 #include <atomic>
+#include <thread>
 #include "scheduler.h"
 
 // Global CPU tick used for FIFO/LRU timestamp tracking
 extern std::atomic<uint64_t> global_cpu_tick;
 
+MemoryManager& MemoryManager::getInstance() {
+    static MemoryManager instance(::config, global_cpu_tick, true);
+    return instance;
+}
+
+MemoryManager::MemoryManager(const Config& settings, const std::atomic<uint64_t>& tickSource,
+                             bool logBackingStore)
+    : config(settings), clock(tickSource), backingStoreLog(logBackingStore) {}
+
 void MemoryManager::initialize() {
     std::lock_guard<std::mutex> lock(memMutex);
     
     // Guard against invalid config
     if (config.memPerFrame == 0) return;
 
-    // Calculate total number of frames
-    totalFrames = config.maxOverallMem / config.memPerFrame;
-    frames.resize(totalFrames);
+    // Calculate total number of frames; the compressed pool lives in RAM too
+    zswapFrames = zswapReservedFrames(config);
+    totalFrames = config.maxOverallMem / config.memPerFrame - zswapFrames;
+
+    // All frames start free; metadata chunks are built on first use
+    frames.reset(totalFrames);
+    freeFrames = totalFrames;
+
+    // Reset the paging disk and backing-store slot layout
+    disk.configure(config.diskScheduler, config.diskSeekTicks, config.diskTransferTicks);
+    swapBase.clear();
+    nextSwapSlot = 0;
+
+    hugeRuns.clear();
+
+    pinnedPages.clear();
+    autoPins.clear();
+    pinnedFrameCount = 0;
+
+    fileMappings.clear();
+    fileFrames.clear();
 
-    // Initialize all frames as free (ownerPid = -1)
-    for (int i = 0; i < totalFrames; ++i) {
-        frames[i] = { i, -1, -1, false, 0, 0 };
+    // Ghost caches as large as physical memory, one per policy
+    ghosts.clear();
+    if (config.ghostPolicies == "on") {
+        ghosts = { GhostCache("fifo"), GhostCache("lru") };
+        for (auto& ghost : ghosts) {
+            ghost.reset(totalFrames);
+        }
     }
 
+    zswapPool.clear();
+    zswapIndex.clear();
+    zswapBytes = 0;
+    writtenWords.clear();
+
+    codeSegments.clear();
+    codeSegmentIds.clear();
+    codeSpaceOf.clear();
+    nextCodeSegmentId = -2;
+
     // Reset backing store log file
-    std::ofstream store("csopesy-backing-store.txt", std::ios::trunc);
-    store.close();
+    if (backingStoreLog) {
+        std::ofstream store("csopesy-backing-store.txt", std::ios::trunc);
+        store.close();
+    }
+}
+
+void MemoryManager::startReclaimer() {
+    if (config.reclaimLowWatermark == 0) return;  // Reclaimer disabled
+    if (reclaimerStarted.exchange(true)) return;  // Already running
+
+    reclaimerThread = std::thread(&MemoryManager::reclaimerLoop, this);
+}
+
+MemoryManager::~MemoryManager() {
+    {
+        std::lock_guard<std::mutex> lock(memMutex);
+        reclaimerStop = true;
+    }
+    reclaimCv.notify_all();
+    if (reclaimerThread.joinable()) reclaimerThread.join();
 }
 
-bool MemoryManager::allocateMemory(int pid, size_t size) {
+void MemoryManager::reclaimerLoop() {
+    std::unique_lock<std::mutex> lock(memMutex);
+
+    while (true) {
+        // Sleep until a fault pushes free frames below the low watermark
+        reclaimCv.wait(lock, [this] {
+            return reclaimerStop ||
+                   freeFrames < std::min<size_t>(config.reclaimLowWatermark, totalFrames);
+        });
+        if (reclaimerStop) return;
+        reclaimRunCount++;
+
+        // Evict in one batch until the high watermark is restored
+        size_t target = std::min<size_t>(config.reclaimHighWatermark, totalFrames);
+        while (freeFrames < target) {
+            int victim = selectVictimFrame();
+            if (victim == -1) break;  // Nothing left to evict
+
+            swapOut(victim);
+            releaseFrame(victim);
+            pagesReclaimedCount++;
+        }
+    }
+}
+
+bool MemoryManager::allocateMemory(int pid, size_t size, size_t maxRss) {
     std::lock_guard<std::mutex> lock(memMutex);
-    
+    createAddressSpace(pid, size, maxRss);
+    return true; // Always succeeds (demand paging)
+}
+
+void MemoryManager::createAddressSpace(int pid, size_t size, size_t maxRss) {
     // Calculate number of pages needed (round up)
     size_t numPages = (size + config.memPerFrame - 1) / config.memPerFrame;
     
@@ -48,137 +138,1104 @@ bool MemoryManager::allocateMemory(int pid, size_t size) {
         pageTables[pid][i] = -1; 
     }
 
-    return true; // Always succeeds (demand paging)
+    // Resident-set cap, rounded down to whole frames (at least one)
+    rssLimitFrames[pid] = maxRss ? std::max<size_t>(1, maxRss / config.memPerFrame) : 0;
+
+    // Reserve a contiguous swap area on the paging disk
+    swapBase[pid] = nextSwapSlot;
+    nextSwapSlot += numPages;
 }
 
-void MemoryManager::deallocateMemory(int pid) {
+void MemoryManager::forkMemory(int parentPid, int childPid, size_t size, size_t maxRss) {
     std::lock_guard<std::mutex> lock(memMutex);
+    createAddressSpace(childPid, size, maxRss);
 
-    // Free all frames owned by this process
-    for (auto& frame : frames) {
-        if (frame.ownerPid == pid) {
-            frame.ownerPid = -1;  // Mark frame as free
-            frame.pageNum = -1;
-            frame.dirty = false;
+    auto parent = pageTables.find(parentPid);
+    if (parent != pageTables.end()) {
+        // Child maps the parent's resident frames; first write copies
+        auto& child = pageTables[childPid];
+        for (const auto& [pageNum, frameIndex] : parent->second) {
+            if (frameIndex == -1) continue;
+            child[pageNum] = frameIndex;
+            frames.sharers(frameIndex).push_back({ childPid, pageNum });
+            rssFrames[childPid]++;
         }
     }
+
+    auto files = fileMappings.find(parentPid);
+    if (files != fileMappings.end()) fileMappings[childPid] = files->second;
+
+    auto words = writtenWords.find(parentPid);
+    if (words != writtenWords.end()) writtenWords[childPid] = words->second;
+    forkCount++;
+}
+
+void MemoryManager::deallocateMemory(int pid) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    // Pins die with the process (its frames are released below)
+    pinnedPages.erase(pid);
+    dropAutoPin(pid);
+
+    // Free all frames owned by this process (other mappings keep shared ones)
+    for (int frameIndex : frames.sharedFrames()) {
+        unmapShared(frameIndex, pid);
+    }
+    for (int frameIndex : frames.framesOwnedBy(pid)) {
+        releaseFrame(frameIndex);  // Mark frame as free
+    }
     
-    // Remove process page table
+    // Remove process page table and reference history
     pageTables.erase(pid);
+    pageLastTouched.erase(pid);
+    swapBase.erase(pid);
+    swappedSets.erase(pid);
+    prepageSets.erase(pid);
+    faultsByPid.erase(pid);
+    rssFrames.erase(pid);
+    rssLimitFrames.erase(pid);
+    writtenWords.erase(pid);
+    fileMappings.erase(pid);
+    zswapDrop(pid);
+    for (auto& ghost : ghosts) {
+        ghost.dropSpace(pid);
+    }
+
+    // Cancel page-ins still in flight (late disk completions are ignored)
+    for (auto it = pendingPageIns.begin(); it != pendingPageIns.end(); ) {
+        if (it->second.pid == pid) it = pendingPageIns.erase(it);
+        else ++it;
+    }
+
+    detachCode(pid);
+}
+
+void MemoryManager::attachCode(int pid, const std::string& image, uint32_t codeBase,
+                               size_t codeBytes) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    // Private code: the pages live in the process's own address space
+    if (config.sharedCode != "on") {
+        reservePages(pid, codeBase, codeBytes);
+        return;
+    }
+    if (codeSpaceOf.count(pid)) return;  // Already attached
+
+    auto existing = codeSegmentIds.find(image);
+    if (existing != codeSegmentIds.end()) {
+        // Same program already loaded: map its frames
+        codeSegments[existing->second].refCount++;
+        codeSpaceOf[pid] = existing->second;
+        codeShareCount++;
+        return;
+    }
+
+    int segId = nextCodeSegmentId--;
+    codeSegments[segId] = { image, 1 };
+    codeSegmentIds[image] = segId;
+    codeSpaceOf[pid] = segId;
+
+    // The segment gets a page table and swap area of its own
+    size_t numPages = reservePages(segId, codeBase, codeBytes);
+    swapBase[segId] = nextSwapSlot;
+    nextSwapSlot += numPages;
+}
+
+void MemoryManager::reserveRange(int pid, uint32_t virtualAddress, size_t bytes) {
+    std::lock_guard<std::mutex> lock(memMutex);
+    reservePages(pid, virtualAddress, bytes);
+}
+
+size_t MemoryManager::reservePages(int space, uint32_t virtualAddress, size_t bytes) {
+    int firstPage = getPageFromAddress(virtualAddress);
+    int lastPage = getPageFromAddress(static_cast<uint32_t>(
+        std::min<uint64_t>(uint64_t{virtualAddress} + std::max<size_t>(bytes, 1) - 1, UINT32_MAX)));
+
+    auto& table = pageTables[space];
+    for (int page = firstPage; page <= lastPage; ++page) {
+        table.try_emplace(page, -1);  // Never disturbs a page that is already mapped
+    }
+    return static_cast<size_t>(lastPage - firstPage) + 1;
+}
+
+void MemoryManager::detachCode(int pid) {
+    auto space = codeSpaceOf.find(pid);
+    if (space == codeSpaceOf.end()) return;
+
+    int segId = space->second;
+    codeSpaceOf.erase(space);
+
+    auto seg = codeSegments.find(segId);
+    if (seg == codeSegments.end() || --seg->second.refCount > 0) return;
+
+    // Last user gone: free the segment's frames and bookkeeping
+    for (int frameIndex : frames.framesOwnedBy(segId)) {
+        releaseFrame(frameIndex);
+    }
+    for (auto it = pendingPageIns.begin(); it != pendingPageIns.end(); ) {
+        if (it->second.pid == segId) it = pendingPageIns.erase(it);
+        else ++it;
+    }
+    pageTables.erase(segId);
+    rssFrames.erase(segId);
+    zswapDrop(segId);
+    for (auto& ghost : ghosts) {
+        ghost.dropSpace(segId);
+    }
+    swapBase.erase(segId);
+    codeSegmentIds.erase(seg->second.image);
+    codeSegments.erase(seg);
+}
+
+int MemoryManager::addressSpace(int pid, bool codeFetch) {
+    if (!codeFetch) return pid;
+    auto it = codeSpaceOf.find(pid);
+    return (it == codeSpaceOf.end()) ? pid : it->second;
 }
 
 int MemoryManager::getPageFromAddress(uint32_t addr) {
     if (config.memPerFrame == 0) return 0;  // Guard against invalid config
-    return addr / config.memPerFrame;
+    return static_cast<int>(addr / config.memPerFrame);
 }
 
-bool MemoryManager::isPageResident(int pid, uint32_t virtualAddress) {
+bool MemoryManager::isPageResident(int pid, uint32_t virtualAddress, PageAccess access) {
     std::lock_guard<std::mutex> lock(memMutex);
     
     int pageNum = getPageFromAddress(virtualAddress);
+    int space = addressSpace(pid, access == PageAccess::FETCH);
+
+    // Every reference counts towards the working set, hit or miss
+    // (shared code belongs to no single process)
+    if (space == pid) pageLastTouched[pid][pageNum] = clock.load();
     
-    if (pageTables.find(pid) == pageTables.end()) return false;
-    if (pageTables[pid].find(pageNum) == pageTables[pid].end()) return false;
+    int frameIndex = -1;
+    auto pt = pageTables.find(space);
+    if (pt != pageTables.end()) {
+        auto entry = pt->second.find(pageNum);
+        if (entry != pt->second.end()) frameIndex = entry->second;
+    }
+    traceReference(pid, pageNum, access, (frameIndex != -1) ? PAGE_TRACE_HIT : 0);
+    for (auto& ghost : ghosts) {
+        ghost.access(space, pageNum);
+    }
+    if (frameIndex == -1) return false;
+
+    // Update last accessed time for LRU policy
+    frames.lastAccessedTick(frameIndex) = clock.load();
+
+    // First use of a prefetched page: the prepage paid off
+    if (frames.hasFlag(frameIndex, FRAME_PREPAGED)) {
+        frames.setFlag(frameIndex, FRAME_PREPAGED, false);
+        prepageHitCount++;
+    }
+
+    // Likewise for a page a huge-frame promotion brought in
+    if (frames.hasFlag(frameIndex, FRAME_HUGE_FILLED)) {
+        frames.setFlag(frameIndex, FRAME_HUGE_FILLED, false);
+        hugeAvoidedCount++;
+    }
+    return true;
+}
+
+void MemoryManager::requestPage(int pid, uint32_t virtualAddress, PageAccess access) {
+    std::lock_guard<std::mutex> lock(memMutex);
+    pageFaultCount++;
+    faultsByPid[pid]++;
+    int pageNum = getPageFromAddress(virtualAddress);
+    traceReference(pid, pageNum, access, PAGE_TRACE_FAULT);
+    loadPage(addressSpace(pid, access == PageAccess::FETCH), pageNum);
+}
+
+uint64_t MemoryManager::startPageIn(int pid, uint32_t virtualAddress, PageAccess access) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    pageFaultCount++;
+    faultsByPid[pid]++;
+    uint64_t id = nextPageInId++;
+    int space = addressSpace(pid, access == PageAccess::FETCH);
+    int pageNum = getPageFromAddress(virtualAddress);
+    traceReference(pid, pageNum, access, PAGE_TRACE_FAULT);
+    uint64_t now = clock.load();
+
+    // Compressed pool hit: decompression only, no disk read
+    if (zswapEnabled() && zswapIndex[space].count(pageNum)) {
+        pendingPageIns[id] = { space, pageNum, now + config.zswapLatency };
+        return id;
+    }
+
+    if (diskEnabled()) {
+        // Ready tick is unknown until the disk gets to this request
+        serviceDisk();
+        pendingPageIns[id] = { space, pageNum, UINT64_MAX };
+        disk.submit({ id, space, pageNum, diskSlot(space, pageNum),
+                      PagingDisk::Op::READ, now });
+        return id;
+    }
+
+    pendingPageIns[id] = { space, pageNum, now + config.pageFaultLatency };
+    return id;
+}
+
+bool MemoryManager::pollPageIn(uint64_t requestId) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    // Completed disk reads are loaded and dropped from pendingPageIns
+    if (diskEnabled()) serviceDisk();
+
+    auto it = pendingPageIns.find(requestId);
+    if (it == pendingPageIns.end()) return true;
+
+    // Page still in transit (disk-bound requests have no ready tick yet)
+    if (clock.load() < it->second.readyTick) return false;
+
+    if (!it->second.loaded) {
+        // A huge-frame promotion keeps the process waiting for the whole region
+        uint64_t fillTicks = loadPage(it->second.pid, it->second.pageNum);
+        if (fillTicks > 0) {
+            it->second.loaded = true;
+            it->second.readyTick = clock.load() + fillTicks;
+            return false;
+        }
+    }
+    pendingPageIns.erase(it);
+    return true;
+}
+
+bool MemoryManager::isAsyncPaging() const {
+    return config.pageFaultLatency > 0 || diskEnabled();
+}
+
+bool MemoryManager::diskEnabled() const {
+    return config.diskScheduler != "none";
+}
+
+bool MemoryManager::zswapEnabled() const {
+    return config.zswapPoolPercent > 0;
+}
+
+size_t MemoryManager::compressedSize(int pid, int pageNum) {
+    size_t words = 0;
+    auto pidWords = writtenWords.find(pid);
+    if (pidWords != writtenWords.end()) {
+        auto pageWords = pidWords->second.find(pageNum);
+        if (pageWords != pidWords->second.end()) words = pageWords->second.size();
+    }
+    return std::min<size_t>(config.memPerFrame, ZSWAP_HEADER_BYTES + words * ZSWAP_BYTES_PER_WORD);
+}
+
+bool MemoryManager::zswapStore(int pid, int pageNum) {
+    size_t bytes = compressedSize(pid, pageNum);
+    size_t capacity = static_cast<size_t>(config.maxOverallMem) * config.zswapPoolPercent / 100;
+
+    // Incompressible (or bigger than the whole pool): straight to disk
+    if (bytes >= config.memPerFrame || bytes > capacity) {
+        zswapRejectCount++;
+        return false;
+    }
 
-    int frameIndex = pageTables[pid][pageNum];
-    if (frameIndex != -1) {
-        // Update last accessed time for LRU policy
-        frames[frameIndex].lastAccessedTick = global_cpu_tick.load();
-        return true;
+    while (zswapBytes + bytes > capacity) {
+        zswapWriteback();
+    }
+
+    zswapPool.push_back({ pid, pageNum, bytes });
+    zswapIndex[pid][pageNum] = std::prev(zswapPool.end());
+    zswapBytes += bytes;
+    zswapStoredOriginal += config.memPerFrame;
+    zswapStoredCompressed += bytes;
+    return true;
+}
+
+bool MemoryManager::zswapLoad(int pid, int pageNum) {
+    auto pidIndex = zswapIndex.find(pid);
+    if (pidIndex == zswapIndex.end()) return false;
+    auto entry = pidIndex->second.find(pageNum);
+    if (entry == pidIndex->second.end()) return false;
+
+    zswapBytes -= entry->second->bytes;
+    zswapPool.erase(entry->second);
+    pidIndex->second.erase(entry);
+    return true;
+}
+
+void MemoryManager::zswapWriteback() {
+    const ZswapEntry& oldest = zswapPool.front();
+
+    if (backingStoreLog) {
+        std::ofstream store("csopesy-backing-store.txt", std::ios::app);
+        store << "SwapOut: PID " << oldest.pid << " Page " << oldest.pageNum
+              << " from zswap pool\n";
+        store.close();
+    }
+
+    if (diskEnabled()) {
+        disk.submit({ 0, oldest.pid, oldest.pageNum, diskSlot(oldest.pid, oldest.pageNum),
+                      PagingDisk::Op::WRITE, clock.load() });
+    }
+
+    zswapBytes -= oldest.bytes;
+    zswapIndex[oldest.pid].erase(oldest.pageNum);
+    zswapPool.pop_front();
+    zswapEvictCount++;
+}
+
+void MemoryManager::zswapDrop(int pid) {
+    auto pidIndex = zswapIndex.find(pid);
+    if (pidIndex == zswapIndex.end()) return;
+
+    for (const auto& [pageNum, entry] : pidIndex->second) {
+        zswapBytes -= entry->bytes;
+        zswapPool.erase(entry);
+    }
+    zswapIndex.erase(pidIndex);
+}
+
+void MemoryManager::serviceDisk() {
+    for (const auto& req : disk.advance(clock.load())) {
+        if (req.op != PagingDisk::Op::READ) continue;  // Write-backs need no follow-up
+
+        auto it = pendingPageIns.find(req.id);
+        if (it == pendingPageIns.end()) continue;
+
+        uint64_t fillTicks = loadPage(req.pid, req.pageNum);
+        if (fillTicks > 0) {
+            // Rest of a huge frame still being read; pollPageIn() waits it out
+            it->second.loaded = true;
+            it->second.readyTick = clock.load() + fillTicks;
+        } else {
+            pendingPageIns.erase(it);
+        }
+    }
+}
+
+bool MemoryManager::markDirty(int pid, uint32_t virtualAddress) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    auto pt = pageTables.find(pid);
+    if (pt == pageTables.end()) return false;
+
+    int pageNum = getPageFromAddress(virtualAddress);
+    if (zswapEnabled()) {
+        writtenWords[pid][pageNum].insert(static_cast<uint32_t>(virtualAddress % config.memPerFrame));
+    }
+    auto entry = pt->second.find(pageNum);
+    if (entry == pt->second.end() || entry->second == -1) return false;
+
+    int frameIndex = entry->second;
+    if (frames.sharers(frameIndex).empty()) {
+        frames.setFlag(frameIndex, FRAME_DIRTY, true);
+        return false;
+    }
+
+    // Copy-on-write fault: the writer moves to a private copy of the page
+    unmapShared(frameIndex, pid);
+    int copy = obtainFrame(pid);
+    mapFrame(pid, pageNum, copy);
+    frames.setFlag(copy, FRAME_DIRTY, true);
+    cowFaultCount++;
+
+    if (freeFrames < config.reclaimLowWatermark) {
+        reclaimCv.notify_one();
+    }
+    return true;
+}
+
+size_t MemoryManager::mergeIdenticalPages(const std::vector<PageContent>& pages) {
+    std::lock_guard<std::mutex> lock(memMutex);
+    mergeScanCount++;
+
+    // Content -> frame that keeps it (hashed, then compared by the map)
+    std::unordered_map<std::string, int> keepers;
+    size_t freed = 0;
+
+    for (const auto& page : pages) {
+        auto pt = pageTables.find(page.pid);
+        if (pt == pageTables.end()) continue;
+        auto entry = pt->second.find(page.pageNum);
+        if (entry == pt->second.end() || entry->second == -1) continue;
+
+        int frameIndex = entry->second;
+        if (fileFrames.count(frameIndex)) continue;  // File pages hold file bytes, not data_memory
+        auto [keeper, inserted] = keepers.try_emplace(page.content, frameIndex);
+        if (inserted || keeper->second == frameIndex) continue;
+
+        // Move every mapping of the duplicate onto the keeper
+        int keep = keeper->second;
+        FrameTable::Mappings mappings = frames.sharers(frameIndex);
+        mappings.push_back({ frames.owner(frameIndex), frames.page(frameIndex) });
+        for (const auto& [pid, pageNum] : mappings) {
+            pageTables[pid][pageNum] = keep;
+            frames.sharers(keep).push_back({ pid, pageNum });
+            rssFrames[pid]++;  // releaseFrame() below drops the old mapping
+        }
+        if (frames.hasFlag(frameIndex, FRAME_DIRTY)) frames.setFlag(keep, FRAME_DIRTY, true);
+
+        frames.setFlag(frameIndex, FRAME_PREPAGED, false);  // Merged, not wasted
+        releaseFrame(frameIndex);
+        updatePin(keep);  // Pins of the merged mappings move with them
+        mergedPageCount++;
+        freed++;
+    }
+    return freed;
+}
+
+int MemoryManager::unmapShared(int frameIndex, int pid) {
+    FrameTable::Mappings& sharers = frames.sharers(frameIndex);
+    int pageNum = -1;
+
+    if (frames.owner(frameIndex) == pid) {
+        // Hand the frame to the first remaining sharer
+        pageNum = frames.page(frameIndex);
+        frames.owner(frameIndex) = sharers.front().first;
+        frames.page(frameIndex) = sharers.front().second;
+        sharers.erase(sharers.begin());
+    } else {
+        auto it = std::find_if(sharers.begin(), sharers.end(),
+                               [pid](const auto& s) { return s.first == pid; });
+        if (it == sharers.end()) return -1;
+        pageNum = it->second;
+        sharers.erase(it);
+    }
+
+    pageTables[pid][pageNum] = -1;
+    rssFrames[pid]--;
+    updatePin(frameIndex);
+    return pageNum;
+}
+
+bool MemoryManager::isPinned(int space, int pageNum) const {
+    auto pinned = pinnedPages.find(space);
+    if (pinned != pinnedPages.end() && pinned->second.count(pageNum)) return true;
+    for (const auto& [pid, page] : autoPins) {
+        if (page.first == space && page.second == pageNum) return true;
     }
     return false;
 }
 
-void MemoryManager::requestPage(int pid, uint32_t virtualAddress) {
+void MemoryManager::updatePin(int frameIndex) {
+    if (frameIndex == -1 || frames.isFree(frameIndex)) return;
+
+    bool wanted = isPinned(frames.owner(frameIndex), frames.page(frameIndex));
+    for (const auto& [pid, pageNum] : frames.sharers(frameIndex)) {
+        wanted = wanted || isPinned(pid, pageNum);
+    }
+
+    bool pinned = frames.hasFlag(frameIndex, FRAME_PINNED);
+    if (wanted == pinned) return;
+    if (wanted && pinnedFrameCount >= config.maxPinnedFrames) {
+        pinRejectCount++;
+        return;
+    }
+    frames.setFlag(frameIndex, FRAME_PINNED, wanted);
+    if (wanted) pinnedFrameCount++;
+    else pinnedFrameCount--;
+}
+
+int MemoryManager::residentFrame(int space, int pageNum) const {
+    auto pt = pageTables.find(space);
+    if (pt == pageTables.end()) return -1;
+    auto entry = pt->second.find(pageNum);
+    return (entry == pt->second.end()) ? -1 : entry->second;
+}
+
+bool MemoryManager::pinPage(int pid, uint32_t virtualAddress) {
     std::lock_guard<std::mutex> lock(memMutex);
-    
+
     int pageNum = getPageFromAddress(virtualAddress);
-    
+    int frameIndex = residentFrame(pid, pageNum);
+
+    // Pinning a page whose frame is already pinned costs nothing
+    bool alreadyPinned = frameIndex != -1 && frames.hasFlag(frameIndex, FRAME_PINNED);
+    if (!alreadyPinned && pinnedFrameCount >= config.maxPinnedFrames) {
+        pinRejectCount++;
+        return false;
+    }
+    pinnedPages[pid].insert(pageNum);
+    updatePin(frameIndex);
+    return true;
+}
+
+void MemoryManager::autoPin(int pid, uint32_t codeAddress) {
+    if (config.autoPin != "on") return;
+
+    std::lock_guard<std::mutex> lock(memMutex);
+    std::pair<int, int> page = { addressSpace(pid, true), getPageFromAddress(codeAddress) };
+    auto current = autoPins.find(pid);
+    if (current != autoPins.end() && current->second == page) return;
+
+    // Release the old page first so it does not hold a slot under the cap
+    dropAutoPin(pid);
+    autoPins[pid] = page;
+    updatePin(residentFrame(page.first, page.second));
+}
+
+void MemoryManager::unpinDispatch(int pid) {
+    std::lock_guard<std::mutex> lock(memMutex);
+    dropAutoPin(pid);
+}
+
+bool MemoryManager::mapFile(int pid, uint32_t virtualAddress, const std::string& path,
+                            uint64_t length) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    if (length == 0 || virtualAddress % config.memPerFrame != 0) return false;
+    if (!std::ifstream(path, std::ios::binary)) return false;
+
+    // The range must lie in the address space and overlap no other mapping
+    auto pt = pageTables.find(pid);
+    if (pt == pageTables.end()) return false;
+    int firstPage = getPageFromAddress(virtualAddress);
+    uint64_t pages = (length + config.memPerFrame - 1) / config.memPerFrame;
+    if (firstPage + pages > pt->second.size()) return false;
+    for (int page = firstPage; page < firstPage + static_cast<int>(pages); ++page) {
+        if (fileMappingOf(pid, page)) return false;
+    }
+
+    // Whatever anonymous data the range held is discarded
+    for (int page = firstPage; page < firstPage + static_cast<int>(pages); ++page) {
+        discardPage(pid, page);
+    }
+
+    // The file gets an extent of its own on the paging disk
+    fileMappings[pid].push_back({ path, firstPage, static_cast<int>(pages), length, nextSwapSlot });
+    nextSwapSlot += pages;
+    return true;
+}
+
+size_t MemoryManager::discardPages(int pid, uint32_t virtualAddress, uint64_t length) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    int firstPage = getPageFromAddress(virtualAddress);
+    int lastPage = getPageFromAddress(static_cast<uint32_t>(
+        std::min<uint64_t>(virtualAddress + std::max<uint64_t>(length, 1) - 1, UINT32_MAX)));
+    size_t released = 0;
+    for (int page = firstPage; page <= lastPage; ++page) {
+        if (discardPage(pid, page)) released++;
+    }
+    discardedPageCount += released;
+    return released;
+}
+
+bool MemoryManager::discardPage(int pid, int pageNum) {
+    auto pt = pageTables.find(pid);
+    if (pt == pageTables.end()) return false;
+    auto entry = pt->second.find(pageNum);
+    if (entry == pt->second.end()) return false;
+
+    bool resident = entry->second != -1;
+    if (resident) {
+        int frameIndex = entry->second;
+        if (!frames.sharers(frameIndex).empty()) {
+            unmapShared(frameIndex, pid);  // The other mappings keep the frame
+        } else {
+            releaseFrame(frameIndex);
+            entry->second = -1;
+        }
+    }
+    zswapLoad(pid, pageNum);
+    auto words = writtenWords.find(pid);
+    if (words != writtenWords.end()) words->second.erase(pageNum);
+    return resident;
+}
+
+bool MemoryManager::isFileMapped(int pid, uint32_t virtualAddress) {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return fileMappingOf(pid, getPageFromAddress(virtualAddress)) != nullptr;
+}
+
+bool MemoryManager::readFileWord(int pid, uint32_t virtualAddress, uint16_t& value) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    int pageNum = getPageFromAddress(virtualAddress);
+    if (!fileMappingOf(pid, pageNum)) return false;
+    int frameIndex = residentFrame(pid, pageNum);
+    auto bytes = (frameIndex == -1) ? fileFrames.end() : fileFrames.find(frameIndex);
+    if (bytes == fileFrames.end()) return false;
+
+    // Little-endian, truncated at the end of the page
+    size_t offset = virtualAddress % config.memPerFrame;
+    value = bytes->second[offset];
+    if (offset + 1 < bytes->second.size()) value |= static_cast<uint16_t>(bytes->second[offset + 1] << 8);
+    return true;
+}
+
+const MemoryManager::FileMapping* MemoryManager::fileMappingOf(int pid, int pageNum) const {
+    auto mappings = fileMappings.find(pid);
+    if (mappings == fileMappings.end()) return nullptr;
+    for (const auto& mapping : mappings->second) {
+        if (pageNum >= mapping.firstPage && pageNum < mapping.firstPage + mapping.pages) return &mapping;
+    }
+    return nullptr;
+}
+
+uint64_t MemoryManager::diskSlot(int pid, int pageNum) const {
+    if (const FileMapping* mapping = fileMappingOf(pid, pageNum)) {
+        return mapping->diskSlot + (pageNum - mapping->firstPage);
+    }
+    auto base = swapBase.find(pid);
+    return ((base == swapBase.end()) ? 0 : base->second) + pageNum;
+}
+
+void MemoryManager::dropAutoPin(int pid) {
+    auto current = autoPins.find(pid);
+    if (current == autoPins.end()) return;
+
+    auto [space, pageNum] = current->second;
+    autoPins.erase(current);
+    updatePin(residentFrame(space, pageNum));
+}
+
+uint64_t MemoryManager::loadPage(int pid, int pageNum) {
     // If page is already resident, nothing to do
-    if (pageTables[pid][pageNum] != -1) return;
+    if (pageTables[pid][pageNum] != -1) return 0;
+
+    // Densely used region: map it all at once with a huge frame
+    uint64_t fillTicks = 0;
+    if (config.hugePageFrames > 0 && promoteHuge(pid, pageNum, fillTicks)) {
+        if (freeFrames < config.reclaimLowWatermark) reclaimCv.notify_one();
+        return fillTicks;
+    }
+
+    // Load the requested page into a frame (from the pool if it is there)
+    if (zswapEnabled() && zswapLoad(pid, pageNum)) zswapHitCount++;
+    swapIn(pid, pageNum, obtainFrame(pid));
+
+    // Wake the background reclaimer before the pool runs dry
+    if (freeFrames < config.reclaimLowWatermark) {
+        reclaimCv.notify_one();
+    }
+    return 0;
+}
+
+bool MemoryManager::promoteHuge(int pid, int pageNum, uint64_t& fillTicks) {
+    int n = static_cast<int>(config.hugePageFrames);
+    int region = pageNum / n;
+    int firstPage = region * n;
+    auto& table = pageTables[pid];
+
+    // The whole region must exist, be unshared and be dense enough
+    int resident = 0;
+    for (int page = firstPage; page < firstPage + n; ++page) {
+        auto entry = table.find(page);
+        if (entry == table.end()) return false;
+        if (entry->second == -1) continue;
+        if (!frames.sharers(entry->second).empty()) return false;
+        resident++;
+    }
+    if (resident + 1 < static_cast<int>(config.hugePromoteThreshold)) return false;
+
+    // Local replacement: the region must fit under the RSS cap
+    auto limit = rssLimitFrames.find(pid);
+    if (config.replacementScope == "local" && limit != rssLimitFrames.end() &&
+        limit->second > 0 && rssFrames[pid] + (n - resident) > limit->second) {
+        return false;
+    }
+
+    // Find a fully free aligned run (no compaction)
+    int runStart = frames.findFreeRun(n, totalFrames);
+    if (runStart == -1) return false;
+
+    size_t filled = 0;
+    size_t pooled = 0;
+    for (int i = 0; i < n; ++i) {
+        int page = firstPage + i;
+        int target = runStart + i;
+        int old = table[page];
+
+        if (old != -1) {
+            // Migrate the resident page (memory-to-memory, no paging)
+            bool dirty = frames.hasFlag(old, FRAME_DIRTY);
+            uint64_t allocated = frames.allocatedTick(old);
+            uint64_t accessed = frames.lastAccessedTick(old);
+            auto fileBytes = fileFrames.extract(old);
+            releaseFrame(old);
+            mapFrame(pid, page, target);
+            if (!fileBytes.empty()) {
+                fileBytes.key() = target;
+                fileFrames.insert(std::move(fileBytes));
+            }
+            frames.setFlag(target, FRAME_DIRTY, dirty);
+            frames.allocatedTick(target) = allocated;
+            frames.lastAccessedTick(target) = accessed;
+        } else {
+            bool fromPool = zswapEnabled() && zswapLoad(pid, page);
+            if (fromPool) zswapHitCount++;
+            swapIn(pid, page, target);
+            frames.setFlag(target, FRAME_HUGE_FILLED, page != pageNum);
+
+            // The faulting page's own read is already paid for by its fault
+            if (page != pageNum) {
+                filled++;
+                if (fromPool) pooled++;
+            }
+        }
+        frames.hugeBase(target) = runStart;
+    }
+
+    hugeRuns[runStart] = { pid, region };
+    hugePromoteCount++;
+    fillTicks = batchReadTicks(filled - pooled, pooled);
+    hugeFillTicks += fillTicks;
+    return true;
+}
+
+uint64_t MemoryManager::batchReadTicks(size_t fromDisk, size_t pooled) const {
+    if (!isAsyncPaging()) return 0;
+    uint64_t ticks = 0;
+    if (fromDisk > 0) {
+        ticks += diskEnabled() ? config.diskSeekTicks + fromDisk * config.diskTransferTicks
+                               : config.pageFaultLatency;
+    }
+    if (pooled > 0) ticks += config.zswapLatency;
+    return ticks;
+}
+
+void MemoryManager::dissolveHuge(int runStart, bool pressure) {
+    if (hugeRuns.erase(runStart) == 0) return;
+
+    for (int i = runStart; i < runStart + static_cast<int>(config.hugePageFrames); ++i) {
+        frames.hugeBase(i) = -1;
+    }
+    if (pressure) hugeDemoteCount++;
+}
+
+int MemoryManager::obtainFrame(int pid) {
+    int frameIndex = -1;
+
+    // Local replacement: a process at its RSS cap gives up one of its own pages
+    if (atRssLimit(pid)) {
+        frameIndex = selectVictimFrame(pid);
+        if (frameIndex != -1) {
+            swapOut(frameIndex);
+            releaseFrame(frameIndex);
+            localReplacementCount++;
+        } else if (unmapSharedVictim(pid)) {
+            // Nothing owned to evict: dropping a shared mapping brings pid under its cap
+            localReplacementCount++;
+        }
+    }
 
     // Try to find a free frame first
-    int frameIndex = findFreeFrame();
+    if (frameIndex == -1) frameIndex = findFreeFrame();
 
     // If no free frames, evict a victim using configured replacement policy
+    // (direct reclaim - the background reclaimer fell behind or is disabled)
     if (frameIndex == -1) {
         frameIndex = selectVictimFrame();
         swapOut(frameIndex);
+        releaseFrame(frameIndex);
+        directReclaimCount++;
     }
+    return frameIndex;
+}
 
-    // Load the requested page into the frame
-    swapIn(pid, pageNum, frameIndex);
+bool MemoryManager::unmapSharedVictim(int pid) {
+    bool leastRecent = config.replacementPolicy == "lru";
+    int victim = -1;
+    uint64_t bestTick = UINT64_MAX;
+
+    for (int frameIndex : frames.sharedFrames()) {
+        if (frames.hasFlag(frameIndex, FRAME_PINNED)) continue;
+
+        bool mapped = frames.owner(frameIndex) == pid;
+        for (const auto& sharer : frames.sharers(frameIndex)) {
+            mapped = mapped || sharer.first == pid;
+        }
+        if (!mapped) continue;
+
+        uint64_t tick = leastRecent ? frames.lastAccessedTick(frameIndex) : frames.allocatedTick(frameIndex);
+        if (tick < bestTick) {
+            bestTick = tick;
+            victim = frameIndex;
+        }
+    }
+    return victim != -1 && unmapShared(victim, pid) != -1;
 }
 
-int MemoryManager::findFreeFrame() {
-    for (int i = 0; i < totalFrames; ++i) {
-        if (frames[i].ownerPid == -1) return i;
+size_t MemoryManager::swapOutProcess(int pid) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    std::vector<int>& pages = swappedSets[pid];
+    for (int frameIndex : frames.sharedFrames()) {
+        // Copy-on-write frame stays resident for the other sharers
+        int pageNum = unmapShared(frameIndex, pid);
+        if (pageNum != -1) pages.push_back(pageNum);
     }
-    return -1;
+    for (int frameIndex : frames.framesOwnedBy(pid)) {
+        pages.push_back(frames.page(frameIndex));
+        swapOut(frameIndex);
+        releaseFrame(frameIndex);
+    }
+
+    if (!pages.empty()) processSwapOutCount++;
+    return pages.size();
 }
 
-int MemoryManager::selectVictimFrame() {
-    int victim = -1;
-    uint64_t bestTick = UINT64_MAX;
+uint64_t MemoryManager::getSwapInCost(int pid) {
+    std::lock_guard<std::mutex> lock(memMutex);
 
-    if (config.replacementPolicy == "lru") {
-        // LRU (Least Recently Used): Evict the frame that hasn't been
-        // accessed for the longest time (smallest lastAccessedTick)
-        for (int i = 0; i < totalFrames; ++i) {
-            if (frames[i].lastAccessedTick < bestTick) {
-                bestTick = frames[i].lastAccessedTick;
-                victim = i;
-            }
-        }
-    } else {
-        // FIFO (First In First Out): Evict the oldest frame
-        // (smallest allocatedTick = earliest arrival time)
-        for (int i = 0; i < totalFrames; ++i) {
-            if (frames[i].allocatedTick < bestTick) {
-                bestTick = frames[i].allocatedTick;
-                victim = i;
-            }
+    auto it = swappedSets.find(pid);
+    size_t pages = (it == swappedSets.end()) ? 0 : it->second.size();
+    if (pages == 0) return 0;
+
+    // The swap area is contiguous, so a batch is one seek + sequential reads;
+    // even a blocking-mode batch costs the tick a single fault would stall
+    uint64_t ticks = diskEnabled() ? config.diskSeekTicks + pages * config.diskTransferTicks
+                                   : config.pageFaultLatency;
+    return std::max<uint64_t>(1, ticks);
+}
+
+size_t MemoryManager::swapInProcess(int pid, uint64_t costTicks) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    auto it = swappedSets.find(pid);
+    if (it == swappedSets.end()) return 0;
+
+    size_t loaded = 0;
+    for (int pageNum : it->second) {
+        if (pageTables[pid][pageNum] != -1) continue;
+        loadPage(pid, pageNum);
+        loaded++;
+    }
+    swappedSets.erase(it);
+
+    processSwapInCount++;
+    batchSwapInPages += loaded;
+    batchSwapInTicks += costTicks;
+    return loaded;
+}
+
+size_t MemoryManager::getSwappedPageCount(int pid) {
+    std::lock_guard<std::mutex> lock(memMutex);
+    auto it = swappedSets.find(pid);
+    return (it == swappedSets.end()) ? 0 : it->second.size();
+}
+
+bool MemoryManager::startTrace(const std::string& path) {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return trace.open(path, config.memPerFrame);
+}
+
+uint64_t MemoryManager::stopTrace() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    if (!trace.isOpen()) return 0;
+    trace.close();
+    return trace.getRecordCount();
+}
+
+bool MemoryManager::isTracing() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return trace.isOpen();
+}
+
+std::string MemoryManager::getTracePath() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return trace.getPath();
+}
+
+uint64_t MemoryManager::getTraceRecordCount() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return trace.getRecordCount();
+}
+
+void MemoryManager::traceReference(int pid, int pageNum, PageAccess access, uint8_t flags) {
+    if (!trace.isOpen()) return;
+    trace.append({ clock.load(), pid, static_cast<uint32_t>(pageNum), access, flags });
+}
+
+void MemoryManager::recordRecentPages(int pid) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    auto it = pageLastTouched.find(pid);
+    if (it == pageLastTouched.end()) return;
+
+    // Forget references that fell out of the working-set window
+    uint64_t now = clock.load();
+    uint64_t cutoff = (now > config.workingSetWindow) ? now - config.workingSetWindow : 0;
+    std::erase_if(it->second, [cutoff](const auto& page) { return page.second < cutoff; });
+
+    if (config.prepagePages == 0) return;
+
+    // Most recently referenced pages first
+    std::vector<std::pair<uint64_t, int>> recent;
+    for (const auto& [pageNum, tick] : it->second) {
+        recent.push_back({ tick, pageNum });
+    }
+    size_t keep = std::min<size_t>(config.prepagePages, recent.size());
+    std::partial_sort(recent.begin(), recent.begin() + keep, recent.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    std::vector<int>& pages = prepageSets[pid];
+    pages.clear();
+    for (size_t i = 0; i < keep; ++i) {
+        pages.push_back(recent[i].second);
+    }
+}
+
+uint64_t MemoryManager::prepage(int pid) {
+    if (config.prepagePages == 0) return 0;
+
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    auto it = prepageSets.find(pid);
+    if (it == prepageSets.end()) return 0;
+
+    size_t loaded = 0;
+    size_t pooled = 0;
+    for (int pageNum : it->second) {
+        if (freeFrames == 0 || atRssLimit(pid)) break;  // Never evict to prefetch
+        if (pageTables[pid][pageNum] != -1) continue;
+
+        int frameIndex = findFreeFrame();
+        if (zswapEnabled() && zswapLoad(pid, pageNum)) {
+            zswapHitCount++;
+            pooled++;
         }
+        swapIn(pid, pageNum, frameIndex);
+        frames.setFlag(frameIndex, FRAME_PREPAGED, true);
+        loaded++;
     }
-    return victim;
+    prepageSets.erase(it);
+    prepagedCount += loaded;
+
+    // Priced like a batch swap-in of the same pages
+    uint64_t cost = batchReadTicks(loaded - pooled, pooled);
+    prepageTicks += cost;
+    return cost;
+}
+
+int MemoryManager::findFreeFrame() {
+    return frames.findFree();
+}
+
+bool MemoryManager::atRssLimit(int pid) {
+    if (config.replacementScope != "local") return false;
+
+    auto limit = rssLimitFrames.find(pid);
+    if (limit == rssLimitFrames.end() || limit->second == 0) return false;
+
+    auto rss = rssFrames.find(pid);
+    return rss != rssFrames.end() && rss->second >= limit->second;
+}
+
+int MemoryManager::selectVictimFrame(int ownerPid) {
+    // LRU (Least Recently Used): Evict the frame that hasn't been
+    // accessed for the longest time (smallest lastAccessedTick)
+    // FIFO (First In First Out): Evict the oldest frame
+    // (smallest allocatedTick = earliest arrival time)
+    // Pinned frames are skipped by the scan itself
+    return frames.findVictim(config.replacementPolicy == "lru", ownerPid);
 }
 
 void MemoryManager::swapOut(int frameIndex) {
-    Frame& f = frames[frameIndex];
-    
-    if (f.ownerPid != -1) {
-        // Log eviction to backing store file
-        std::ofstream store("csopesy-backing-store.txt", std::ios::app);
-        store << "SwapOut: PID " << f.ownerPid << " Page " << f.pageNum 
-              << " from Frame " << f.frameId << "\n";
-        store.close();
+    // Evicting part of a huge frame: demote it to base frames first
+    if (frames.hugeBase(frameIndex) != -1) dissolveHuge(frames.hugeBase(frameIndex), true);
+
+    int owner = frames.owner(frameIndex);
+    int page = frames.page(frameIndex);
+    if (owner != -1) {
+        // Clean file pages are dropped: the file still holds them
+        bool filePage = fileFrames.count(frameIndex) > 0;
+        if (filePage) fileDropCount++;
 
-        // Mark page as not resident in page table
-        pageTables[f.ownerPid][f.pageNum] = -1;
-        pagedOutCount++;
+        // Kept compressed in RAM if possible; the backing store sees it on writeback
+        bool pooled = !filePage && zswapEnabled() && zswapStore(owner, page);
+        if (!filePage && !pooled) {
+            // Log eviction to backing store file
+            if (backingStoreLog) {
+                std::ofstream store("csopesy-backing-store.txt", std::ios::app);
+                store << "SwapOut: PID " << owner << " Page " << page 
+                      << " from Frame " << frameIndex << "\n";
+                store.close();
+            }
+
+            // Dirty pages must be written back through the paging disk
+            if (diskEnabled() && frames.hasFlag(frameIndex, FRAME_DIRTY)) {
+                disk.submit({ 0, owner, page, diskSlot(owner, page),
+                              PagingDisk::Op::WRITE, clock.load() });
+            }
+        }
+
+        // Mark page as not resident in page table (and in every sharer's)
+        pageTables[owner][page] = -1;
+        for (const auto& [pid, pageNum] : frames.sharers(frameIndex)) {
+            pageTables[pid][pageNum] = -1;
+        }
+        if (!filePage) pagedOutCount++;
     }
 }
 
 void MemoryManager::swapIn(int pid, int pageNum, int frameIndex) {
+    if (const FileMapping* mapping = fileMappingOf(pid, pageNum)) {
+        // File page: read it from the host file (past the mapped bytes is zero)
+        std::vector<uint8_t> bytes(config.memPerFrame, 0);
+        uint64_t offset = static_cast<uint64_t>(pageNum - mapping->firstPage) * config.memPerFrame;
+        if (offset < mapping->length) {
+            std::ifstream file(mapping->path, std::ios::binary);
+            file.seekg(static_cast<std::streamoff>(offset));
+            file.read(reinterpret_cast<char*>(bytes.data()),
+                      static_cast<std::streamsize>(std::min<uint64_t>(config.memPerFrame,
+                                                                      mapping->length - offset)));
+        }
+        mapFrame(pid, pageNum, frameIndex);
+        fileFrames[frameIndex] = std::move(bytes);
+        filePageInCount++;
+        return;
+    }
+
     // Log page load to backing store file
-    std::ofstream store("csopesy-backing-store.txt", std::ios::app);
-    store << "SwapIn: PID " << pid << " Page " << pageNum 
-          << " into Frame " << frameIndex << "\n";
-    store.close();
+    if (backingStoreLog) {
+        std::ofstream store("csopesy-backing-store.txt", std::ios::app);
+        store << "SwapIn: PID " << pid << " Page " << pageNum 
+              << " into Frame " << frameIndex << "\n";
+        store.close();
+    }
+
+    mapFrame(pid, pageNum, frameIndex);
+    pagedInCount++;
+}
 
+void MemoryManager::mapFrame(int pid, int pageNum, int frameIndex) {
     // Assign frame to this process and page
-    frames[frameIndex].ownerPid = pid;
-    frames[frameIndex].pageNum = pageNum;
-    frames[frameIndex].dirty = false;
+    if (frames.owner(frameIndex) == -1) {
+        freeFrames--;
+        frames.markUsed(frameIndex);
+    }
+    frames.owner(frameIndex) = pid;
+    rssFrames[pid]++;
+    frames.page(frameIndex) = pageNum;
+    frames.setFlag(frameIndex, FRAME_DIRTY | FRAME_PREPAGED, false);
 
     // Set timestamps to current CPU tick (critical for FIFO/LRU)
-    uint64_t now = global_cpu_tick.load();
-    frames[frameIndex].allocatedTick = now;      // Used by FIFO
-    frames[frameIndex].lastAccessedTick = now;   // Used by LRU
+    uint64_t now = clock.load();
+    frames.allocatedTick(frameIndex) = now;      // Used by FIFO
+    frames.lastAccessedTick(frameIndex) = now;   // Used by LRU
 
     // Update page table mapping
     pageTables[pid][pageNum] = frameIndex;
-    pagedInCount++;
+    updatePin(frameIndex);
+}
+
+void MemoryManager::releaseFrame(int frameIndex) {
+    if (frames.owner(frameIndex) == -1) return;
+
+    if (frames.hugeBase(frameIndex) != -1) dissolveHuge(frames.hugeBase(frameIndex), false);
+
+    // A prefetched page that was never referenced was wasted I/O
+    if (frames.hasFlag(frameIndex, FRAME_PREPAGED)) prepageWasteCount++;
+    if (frames.hasFlag(frameIndex, FRAME_PINNED)) pinnedFrameCount--;
+
+    rssFrames[frames.owner(frameIndex)]--;
+    FrameTable::Mappings& sharers = frames.sharers(frameIndex);
+    for (const auto& [pid, pageNum] : sharers) {
+        rssFrames[pid]--;
+    }
+    sharers.clear();
+    fileFrames.erase(frameIndex);
+    frames.owner(frameIndex) = -1;
+    frames.page(frameIndex) = -1;
+    frames.setFlag(frameIndex, FRAME_DIRTY | FRAME_PREPAGED | FRAME_HUGE_FILLED | FRAME_PINNED, false);
+    freeFrames++;
+    frames.markFree(frameIndex);
 }
 
 size_t MemoryManager::getTotalMemory() {
@@ -187,11 +1244,7 @@ size_t MemoryManager::getTotalMemory() {
 
 size_t MemoryManager::getUsedMemory() {
     std::lock_guard<std::mutex> lock(memMutex);
-    size_t used = 0;
-    for(const auto& f : frames) {
-        if(f.ownerPid != -1) used++;
-    }
-    return used * config.memPerFrame;
+    return (totalFrames - freeFrames + zswapFrames) * config.memPerFrame;
 }
 
 size_t MemoryManager::getFreeMemory() {
@@ -200,12 +1253,236 @@ size_t MemoryManager::getFreeMemory() {
 
 size_t MemoryManager::getProcessRSS(int pid) {
     std::lock_guard<std::mutex> lock(memMutex);
-    size_t pages = 0;
-    for(const auto& f : frames) {
-        if(f.ownerPid == pid) pages++;
+    auto it = rssFrames.find(pid);
+    return (it == rssFrames.end()) ? 0 : it->second * config.memPerFrame;
+}
+
+size_t MemoryManager::getTotalFrames() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return totalFrames;
+}
+
+double MemoryManager::getResidentFraction(int pid, uint32_t codeAddress,
+                                          const std::vector<uint32_t>& dataAddresses) {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    // Distinct (page-table owner, page) pairs
+    std::vector<std::pair<int, int>> pages = {
+        { addressSpace(pid, true), getPageFromAddress(codeAddress) }
+    };
+    for (uint32_t addr : dataAddresses) {
+        std::pair<int, int> page = { pid, getPageFromAddress(addr) };
+        if (std::find(pages.begin(), pages.end(), page) == pages.end()) {
+            pages.push_back(page);
+        }
+    }
+
+    size_t resident = 0;
+    for (const auto& [space, pageNum] : pages) {
+        auto pt = pageTables.find(space);
+        if (pt == pageTables.end()) continue;
+        auto entry = pt->second.find(pageNum);
+        if (entry != pt->second.end() && entry->second != -1) resident++;
     }
-    return pages * config.memPerFrame;
+    return static_cast<double>(resident) / pages.size();
+}
+
+std::vector<int> MemoryManager::getResidentPages(int pid) const {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    std::vector<int> resident;
+    auto pt = pageTables.find(pid);
+    if (pt == pageTables.end()) return resident;
+    for (const auto& [pageNum, frameIndex] : pt->second) {
+        if (frameIndex != -1) resident.push_back(pageNum);
+    }
+    std::sort(resident.begin(), resident.end());
+    return resident;
+}
+
+size_t MemoryManager::getFreeFrameCount() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return freeFrames;
+}
+
+size_t MemoryManager::getFrameMetadataBytes() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return frames.getMetadataBytes();
+}
+
+size_t MemoryManager::getWorkingSetSize(int pid, uint64_t window) const {
+    std::lock_guard<std::mutex> lock(memMutex);
+
+    auto it = pageLastTouched.find(pid);
+    if (it == pageLastTouched.end()) return 0;
+
+    uint64_t now = clock.load();
+    uint64_t cutoff = (now > window) ? now - window : 0;
+    return static_cast<size_t>(std::count_if(it->second.begin(), it->second.end(),
+        [cutoff](const auto& page) { return page.second >= cutoff; }));
+}
+
+uint64_t MemoryManager::getProcessFaults(int pid) {
+    std::lock_guard<std::mutex> lock(memMutex);
+    auto it = faultsByPid.find(pid);
+    return (it == faultsByPid.end()) ? 0 : it->second;
 }
 
 uint64_t MemoryManager::getNumPagedIn() { return pagedInCount.load(); }
-uint64_t MemoryManager::getNumPagedOut() { return pagedOutCount.load(); }
\ No newline at end of file
+uint64_t MemoryManager::getNumPagedOut() { return pagedOutCount.load(); }
+uint64_t MemoryManager::getNumPageFaults() { return pageFaultCount.load(); }
+
+uint64_t MemoryManager::getNumReclaimRuns() { return reclaimRunCount.load(); }
+uint64_t MemoryManager::getNumPagesReclaimed() { return pagesReclaimedCount.load(); }
+uint64_t MemoryManager::getNumDirectReclaims() { return directReclaimCount.load(); }
+
+size_t MemoryManager::getNumPendingPageIns() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return pendingPageIns.size();
+}
+
+uint64_t MemoryManager::getNumLocalReplacements() { return localReplacementCount.load(); }
+
+size_t MemoryManager::getNumFramesSaved() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    size_t saved = 0;
+    for (int frameIndex : frames.sharedFrames()) {
+        saved += frames.sharers(frameIndex).size();
+    }
+    return saved;
+}
+
+uint64_t MemoryManager::getNumMergedPages() { return mergedPageCount.load(); }
+uint64_t MemoryManager::getNumMergeScans() { return mergeScanCount.load(); }
+
+uint64_t MemoryManager::getNumForks() { return forkCount.load(); }
+uint64_t MemoryManager::getNumCowFaults() { return cowFaultCount.load(); }
+
+size_t MemoryManager::getNumSharedFrames() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return frames.sharedFrames().size();
+}
+
+size_t MemoryManager::getNumCodeSegments() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return codeSegments.size();
+}
+
+size_t MemoryManager::getSharedCodeFrames() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    size_t resident = 0;
+    for (const auto& [segId, seg] : codeSegments) {
+        auto it = rssFrames.find(segId);
+        if (it != rssFrames.end()) resident += it->second;
+    }
+    return resident;
+}
+
+uint64_t MemoryManager::getNumCodeShares() { return codeShareCount.load(); }
+
+uint64_t MemoryManager::getNumPrepagedPages() { return prepagedCount.load(); }
+uint64_t MemoryManager::getPrepageTicks() { return prepageTicks.load(); }
+uint64_t MemoryManager::getNumPrepageHits() { return prepageHitCount.load(); }
+uint64_t MemoryManager::getNumPrepageWaste() { return prepageWasteCount.load(); }
+
+uint64_t MemoryManager::getNumProcessSwapOuts() { return processSwapOutCount.load(); }
+uint64_t MemoryManager::getNumProcessSwapIns() { return processSwapInCount.load(); }
+uint64_t MemoryManager::getNumBatchSwapInPages() { return batchSwapInPages.load(); }
+uint64_t MemoryManager::getBatchSwapInTicks() { return batchSwapInTicks.load(); }
+
+size_t MemoryManager::getNumHugePages() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return hugeRuns.size();
+}
+
+uint64_t MemoryManager::getNumHugePromotions() { return hugePromoteCount.load(); }
+uint64_t MemoryManager::getNumHugeDemotions() { return hugeDemoteCount.load(); }
+uint64_t MemoryManager::getNumHugeFaultsAvoided() { return hugeAvoidedCount.load(); }
+uint64_t MemoryManager::getHugeFillTicks() { return hugeFillTicks.load(); }
+
+uint64_t MemoryManager::getGhostFaults(const std::string& policy) {
+    std::lock_guard<std::mutex> lock(memMutex);
+    for (const auto& ghost : ghosts) {
+        if (ghost.getPolicy() == policy) return ghost.getFaults();
+    }
+    return 0;
+}
+
+uint64_t MemoryManager::getGhostReferences() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return ghosts.empty() ? 0 : ghosts.front().getReferences();
+}
+
+size_t MemoryManager::getNumPinnedFrames() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return pinnedFrameCount;
+}
+
+uint64_t MemoryManager::getNumPinRejects() { return pinRejectCount.load(); }
+
+size_t MemoryManager::getNumFileMappings() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    size_t count = 0;
+    for (const auto& [pid, mappings] : fileMappings) {
+        count += mappings.size();
+    }
+    return count;
+}
+
+uint64_t MemoryManager::getNumFilePageIns() { return filePageInCount.load(); }
+uint64_t MemoryManager::getNumFileDrops() { return fileDropCount.load(); }
+uint64_t MemoryManager::getNumDiscardedPages() { return discardedPageCount.load(); }
+
+size_t MemoryManager::getZswapPoolBytes() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return zswapBytes;
+}
+
+size_t MemoryManager::zswapReservedFrames(const Config& settings) {
+    if (settings.memPerFrame == 0) return 0;
+    uint64_t poolBytes = settings.maxOverallMem * settings.zswapPoolPercent / 100;
+    return static_cast<size_t>((poolBytes + settings.memPerFrame - 1) / settings.memPerFrame);
+}
+
+size_t MemoryManager::getZswapPoolCapacity() {
+    return static_cast<size_t>(config.maxOverallMem) * config.zswapPoolPercent / 100;
+}
+
+size_t MemoryManager::getZswapStoredPages() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return zswapPool.size();
+}
+
+double MemoryManager::getZswapCompressionRatio() {
+    uint64_t compressed = zswapStoredCompressed.load();
+    return compressed ? static_cast<double>(zswapStoredOriginal.load()) / compressed : 0.0;
+}
+
+uint64_t MemoryManager::getZswapHits() { return zswapHitCount.load(); }
+uint64_t MemoryManager::getZswapEvictions() { return zswapEvictCount.load(); }
+uint64_t MemoryManager::getZswapRejects() { return zswapRejectCount.load(); }
+
+size_t MemoryManager::getDiskQueueDepth() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return disk.getQueueDepth();
+}
+
+size_t MemoryManager::getDiskMaxQueueDepth() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return disk.getMaxQueueDepth();
+}
+
+uint64_t MemoryManager::getDiskNumCompleted() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return disk.getNumCompleted();
+}
+
+double MemoryManager::getDiskAvgServiceTicks() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return disk.getAvgServiceTicks();
+}
+
+double MemoryManager::getDiskAvgResponseTicks() {
+    std::lock_guard<std::mutex> lock(memMutex);
+    return disk.getAvgResponseTicks();
+}
\ No newline at end of file
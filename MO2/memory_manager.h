@@ -8,12 +8,20 @@
 
 #pragma once
 #include "config.h"
+#include "paging_disk.h"
+#include "frame_table.h"
+#include "page_trace.h"
+#include "ghost_cache.h"
 #include <vector>
+#include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <string>
 #include <atomic>
 #include <fstream>
+#include <condition_variable>
+#include <thread>
 
 extern Config config;
 
@@ -26,6 +34,19 @@ extern Config config;
  * - FIFO or LRU replacement policy (configured via config.replacementPolicy)
  * - Per-process page tables mapping virtual pages to physical frames
  * - Backing store simulation (csopesy-backing-store.txt)
+ * - Background reclaimer that keeps free frames between the low/high watermarks
+ * - Optional simulated paging disk (FCFS/SSTF/SCAN) timing page-ins and dirty page-outs
+ * - Per-process working-set tracking for load control
+ * - Whole-process swap-out / batch swap-in for the medium-term scheduler
+ * - Batch prepaging of a process's recent pages on re-dispatch
+ * - Per-process resident-set caps with local or global replacement
+ * - Reference-counted code segments shared by processes running the same program
+ * - Fork with copy-on-write sharing of resident frames
+ * - Same-page merging of identical resident data pages
+ * - Optional compressed in-memory swap pool in front of the backing store
+ * - Optional huge frames: promotion of densely used regions, demotion on eviction
+ * - Binary page-reference trace recording (see page_trace.h)
+ * - Optional ghost caches shadowing every replacement policy on live references
  * - Memory statistics (RSS, paged in/out counts)
  */
 class MemoryManager {
@@ -33,85 +54,500 @@ public:
     /**
      * @brief Get singleton instance
      * @return Reference to the global MemoryManager instance
+     * 
+     * The singleton runs on the global config and global_cpu_tick and
+     * logs to the backing-store file.
+     */
+    static MemoryManager& getInstance();
+
+    /**
+     * @brief Build a standalone memory manager (e.g. for trace replay)
+     * @param settings Configuration to use (must outlive the instance)
+     * @param tickSource Clock for FIFO/LRU timestamps (must outlive the instance)
+     * @param logBackingStore Write page-ins/outs to csopesy-backing-store.txt
+     * 
+     * Call initialize() before use. The reclaimer only runs if started.
      */
-    static MemoryManager& getInstance() {
-        static MemoryManager instance;
-        return instance;
-    }
+    MemoryManager(const Config& settings, const std::atomic<uint64_t>& tickSource,
+                  bool logBackingStore);
+
+    /**
+     * @brief Stop and join the reclaimer so the condition variable is not
+     *        destroyed with a thread still waiting on it
+     */
+    ~MemoryManager();
 
     /**
      * @brief Initialize memory manager and backing store
      * 
-     * Allocates frame pool based on config.maxOverallMem / config.memPerFrame.
-     * Resets backing store file.
+     * Sizes the frame pool to config.maxOverallMem / config.memPerFrame.
+     * Frame metadata is allocated per chunk on first use, so startup cost
+     * does not grow with simulated RAM.
+     * Resets backing store file (if this instance logs to it).
      */
     void initialize();
+
+    /**
+     * @brief Start the background page reclaimer thread
+     * 
+     * The reclaimer sleeps until the number of free frames drops below
+     * config.reclaimLowWatermark, then evicts frames in one batch (using the
+     * configured replacement policy) until config.reclaimHighWatermark frames
+     * are free. Does nothing if the low watermark is 0. Safe to call more
+     * than once; only one thread is ever spawned.
+     */
+    void startReclaimer();
     
     /**
      * @brief Allocate virtual memory for a process
      * @param pid Process ID
      * @param size Memory size in bytes
+     * @param maxRss Resident-set cap in bytes (0 = unlimited)
      * @return true (always succeeds - uses demand paging)
      * 
      * Creates page table entries initialized to -1 (not in RAM).
      * Actual frames are allocated on-demand via page faults.
+     * With replacement-scope local, a process holding maxRss bytes of
+     * frames replaces its own pages instead of taking new frames.
      */
-    bool allocateMemory(int pid, size_t size);
+    bool allocateMemory(int pid, size_t size, size_t maxRss = 0);
     
     /**
      * @brief Deallocate all memory for a process
      * @param pid Process ID
      * 
-     * Frees all frames owned by this process and removes page table.
+     * Frees all frames owned by this process, leaves every frame it shares
+     * copy-on-write, drops its pins, code-segment reference, ghost-cache
+     * entries and any page-ins still in flight. Called when a process
+     * finishes, violates memory or is OOM-killed.
      */
     void deallocateMemory(int pid);
     
+    /**
+     * @brief Give a forked child the parent's address space, copy-on-write
+     * @param parentPid Forking process
+     * @param childPid New process (must not have memory yet)
+     * @param size Memory size in bytes
+     * @param maxRss Resident-set cap in bytes (0 = unlimited)
+     * 
+     * The child's page table maps every frame the parent has resident; each
+     * such frame becomes shared until one side writes it (see markDirty()).
+     * Non-resident pages start out non-resident for the child too.
+     */
+    void forkMemory(int parentPid, int childPid, size_t size, size_t maxRss = 0);
+
+    /**
+     * @struct PageContent
+     * @brief Contents of one process data page, as seen by the merge scanner
+     */
+    struct PageContent {
+        int pid;                     ///< Process ID
+        int pageNum;                 ///< Virtual page number
+        std::string content;         ///< Canonical encoding of the page's data
+    };
+
+    /**
+     * @brief Merge resident pages with identical contents (same-page merging)
+     * @param pages Pages to consider; non-resident ones are skipped
+     * @return Frames freed by this call
+     * 
+     * Pages are bucketed by a hash of their content and compared in full.
+     * Every duplicate is remapped onto the first frame holding that content
+     * and its own frame is freed. The surviving frame is shared copy-on-write,
+     * so a later WRITE gives the writer a private copy (see markDirty()).
+     */
+    size_t mergeIdenticalPages(const std::vector<PageContent>& pages);
+
+    /**
+     * @brief Create the pages a process fetches its instructions from
+     * @param pid Process ID
+     * @param image Canonical text of the program (identical programs match)
+     * @param codeBase Virtual address of the first instruction
+     * @param codeBytes Encoded size of the program's code
+     * 
+     * With shared-code on, processes attached to the same image fetch
+     * instructions from the same frames; the segment is created on first use
+     * and reference counted. Otherwise the code pages are added to the
+     * process's own page table, clear of its data pages.
+     */
+    void attachCode(int pid, const std::string& image, uint32_t codeBase, size_t codeBytes);
+
+    /**
+     * @brief Add non-resident pages for a range outside the data area
+     * @param pid Process ID (its address space must exist)
+     * @param virtualAddress Start of the range
+     * @param bytes Length of the range (at least one page is added)
+     * 
+     * Pages that already exist are left alone.
+     */
+    void reserveRange(int pid, uint32_t virtualAddress, size_t bytes);
+
+    /**
+     * @brief Map a host file read-only into a process's address space (MMAP)
+     * @param pid Process ID
+     * @param virtualAddress Start of the range (page aligned)
+     * @param path Host file to map
+     * @param length Bytes to map (the range is rounded up to whole pages)
+     * @return false if the address is unaligned, the range leaves the address
+     *         space or overlaps another mapping, or the file cannot be opened
+     * 
+     * Anonymous pages in the range are discarded. Faults on the range read
+     * the page from the file (through the paging disk when it is enabled)
+     * instead of the backing store, and evicting a file page just drops it:
+     * it is always clean, so it needs no swap slot and no write-back.
+     * Forked children inherit the mapping.
+     */
+    bool mapFile(int pid, uint32_t virtualAddress, const std::string& path, uint64_t length);
+
+    /**
+     * @brief True if an address lies in one of a process's file mappings
+     */
+    bool isFileMapped(int pid, uint32_t virtualAddress);
+
+    /**
+     * @brief Read a 16-bit little-endian word through a file mapping
+     * @param pid Process ID
+     * @param virtualAddress Address in a file mapping (page must be resident)
+     * @param value Receives the word (0 past the end of the mapped bytes)
+     * @return false if the address is not file-mapped or not resident
+     */
+    bool readFileWord(int pid, uint32_t virtualAddress, uint16_t& value);
+
+    /**
+     * @brief Give back the frames behind a range whose contents are dead
+     * @param pid Process ID
+     * @param virtualAddress Start of the range (rounded down to a page)
+     * @param length Bytes in the range
+     * @return Frames released or unshared
+     * 
+     * Used when FREE empties heap pages. The pages stay in the address
+     * space but lose their contents (no write-back, pool entry or written
+     * words), so the process's RSS drops and the next touch faults them in
+     * afresh.
+     */
+    size_t discardPages(int pid, uint32_t virtualAddress, uint64_t length);
+
     /**
      * @brief Check if a virtual address is resident in physical memory
      * @param pid Process ID
      * @param virtualAddress Virtual address to check
+     * @param access Reference kind (FETCH may hit a shared segment)
      * @return true if page is in RAM, false if page fault needed
      * 
-     * Side effect: Updates lastAccessedTick for LRU replacement policy.
+     * Side effects: Updates lastAccessedTick for LRU replacement policy and
+     * records the reference in the process's working set (shared code is not
+     * charged to any one process) and in the trace while recording.
      */
-    bool isPageResident(int pid, uint32_t virtualAddress);
+    bool isPageResident(int pid, uint32_t virtualAddress, PageAccess access = PageAccess::READ);
     
     /**
      * @brief Handle page fault by loading page into memory
      * @param pid Process ID
      * @param virtualAddress Virtual address that triggered fault
+     * @param access Reference kind (FETCH may hit a shared segment)
+     * 
+     * If no free frames available, evicts a victim using configured policy
+     * (direct reclaim). Wakes the background reclaimer when free frames fall
+     * below the low watermark.
+     */
+    void requestPage(int pid, uint32_t virtualAddress, PageAccess access = PageAccess::READ);
+
+    /**
+     * @brief Queue an asynchronous page-in (non-blocking fault)
+     * @param pid Process ID
+     * @param virtualAddress Virtual address that triggered fault
+     * @param access Reference kind (FETCH may hit a shared segment)
+     * @return Request ID to poll with pollPageIn()
+     * 
+     * The page is loaded config.pageFaultLatency ticks from now, or when the
+     * paging disk finishes the read if the disk model is enabled. Pages held
+     * in the compressed pool arrive after config.zswapLatency ticks instead.
+     * The faulting process is expected to give up its core in the meantime.
+     */
+    uint64_t startPageIn(int pid, uint32_t virtualAddress, PageAccess access = PageAccess::READ);
+
+    /**
+     * @brief Check whether an asynchronous page-in has completed
+     * @param requestId ID returned by startPageIn()
+     * @return true once the page has been loaded into a frame
+     * 
+     * Completes the request (allocating a frame, evicting if necessary)
+     * when its service time has elapsed. Unknown IDs count as complete.
+     */
+    bool pollPageIn(uint64_t requestId);
+
+    /**
+     * @brief Whether faults should use startPageIn()/pollPageIn()
+     * @return true if page-fault-latency > 0 or the paging disk is enabled
+     */
+    bool isAsyncPaging() const;
+
+    /**
+     * @brief Mark the page holding an address as modified
+     * @param pid Process ID
+     * @param virtualAddress Address that was written
+     * @return true if the write hit a copy-on-write frame and was given a
+     *         private copy (COW fault)
+     * 
+     * Dirty pages cost a disk write when evicted (paging disk model). With
+     * the compressed pool on, the written word is also remembered so the
+     * page's compressed size can be estimated.
+     * A COW copy takes a free frame, evicting if necessary, but needs no
+     * backing-store read.
+     */
+    bool markDirty(int pid, uint32_t virtualAddress);
+
+    /**
+     * @brief Evict every resident page of a process in one go
+     * @param pid Process ID
+     * @return Number of pages swapped out
+     * 
+     * The evicted pages are remembered so swapInProcess() can restore them.
+     */
+    size_t swapOutProcess(int pid);
+
+    /**
+     * @brief Ticks needed to bring back a swapped-out process
+     * @param pid Process ID
+     * @return One seek plus a sequential transfer per page with the paging
+     *         disk, otherwise a single page-fault latency for the batch;
+     *         at least one tick for any non-empty batch (0 if none)
+     */
+    uint64_t getSwapInCost(int pid);
+
+    /**
+     * @brief Reload the pages remembered by swapOutProcess()
+     * @param pid Process ID
+     * @param costTicks Ticks the batch took (for statistics)
+     * @return Number of pages loaded
+     */
+    size_t swapInProcess(int pid, uint64_t costTicks);
+
+    /**
+     * @brief Pages a swapped-out process will bring back
+     * @param pid Process ID
+     */
+    size_t getSwappedPageCount(int pid);
+
+    /**
+     * @brief Fraction of the pages a process is about to touch that are resident
+     * @param pid Process ID
+     * @param codeAddress Next instruction-fetch address
+     * @param dataAddresses Data addresses of the next instruction
+     * @return Resident pages / distinct pages
+     * 
+     * Read-only: does not update LRU timestamps or the working set.
+     */
+    double getResidentFraction(int pid, uint32_t codeAddress,
+                               const std::vector<uint32_t>& dataAddresses);
+
+    /**
+     * @brief Pages of a process's own page table that are resident
+     * @param pid Process ID
+     * @return Virtual page numbers, ascending
+     */
+    std::vector<int> getResidentPages(int pid) const;
+
+    /**
+     * @brief Start recording page references to a trace file
+     * @param path Trace file (truncated)
+     * @return false if the file could not be created
+     * 
+     * Replaces any trace already being recorded. See page_trace.h for
+     * the file format.
+     */
+    bool startTrace(const std::string& path);
+
+    /**
+     * @brief Stop recording and flush the trace file
+     * @return Records written (0 if no trace was running)
+     */
+    uint64_t stopTrace();
+
+    bool isTracing();                  ///< True while a trace is being recorded
+    std::string getTracePath();        ///< Current or last trace file
+    uint64_t getTraceRecordCount();    ///< Records in the current or last trace
+
+    /**
+     * @brief Remember the pages a process touched most recently
+     * @param pid Process ID
+     * 
+     * Called when the process leaves a core. Forgets references older than
+     * config.workingSetWindow, then keeps up to config.prepagePages pages,
+     * most recent first (nothing kept if prepaging is off).
+     */
+    void recordRecentPages(int pid);
+
+    /**
+     * @brief Prefetch the pages remembered by recordRecentPages()
+     * @param pid Process ID
+     * @return Ticks the batch read takes (0 with blocking page faults)
      * 
-     * If no free frames available, evicts a victim using configured policy.
+     * Called on dispatch. Pages are loaded in one batch into free frames
+     * only, so prepaging never evicts anything. Prepaged frames are flagged
+     * so later hits and wasted (never used) prefetches can be counted.
+     * The batch costs what a batch swap-in of the same pages would; the
+     * caller stalls the process for that long.
      */
-    void requestPage(int pid, uint32_t virtualAddress);
+    uint64_t prepage(int pid);
+
+    /**
+     * @brief Pin the page holding an address (PIN instruction)
+     * @param pid Process ID
+     * @param virtualAddress Data address in the process's space
+     * @return false if the pinned-frame cap is full (the pin is rejected)
+     * 
+     * The pin lasts until the process exits. A pinned page is never chosen
+     * as a replacement victim; if it leaves memory anyway (whole-process
+     * swap-out) the pin is re-applied when it is mapped again.
+     */
+    bool pinPage(int pid, uint32_t virtualAddress);
+
+    /**
+     * @brief Pin the page a running process is executing from
+     * @param pid Process ID
+     * @param codeAddress Current instruction address
+     * 
+     * Replaces the process's previous automatic pin. Held until
+     * unpinDispatch(). No-op unless config.autoPin is "on".
+     */
+    void autoPin(int pid, uint32_t codeAddress);
+
+    /**
+     * @brief Drop the automatic pin of a process leaving its core
+     * @param pid Process ID
+     */
+    void unpinDispatch(int pid);
+
 
     // Memory statistics
     size_t getFreeMemory();      ///< Get free memory in bytes
     size_t getUsedMemory();      ///< Get used memory in bytes
     size_t getTotalMemory();     ///< Get total physical memory in bytes
     size_t getProcessRSS(int pid); ///< Get resident set size (bytes) for process
+    uint64_t getProcessFaults(int pid); ///< Get page faults raised by a process
+    size_t getTotalFrames();     ///< Get number of physical frames
+    size_t getFreeFrameCount();  ///< Get number of free frames
+    size_t getFrameMetadataBytes(); ///< Host memory held by frame metadata
+
+    /**
+     * @brief Estimate a process's working set
+     * @param pid Process ID
+     * @param window Working-set window in ticks
+     * @return Distinct pages referenced in the last window ticks
+     */
+    size_t getWorkingSetSize(int pid, uint64_t window) const;
     
     uint64_t getNumPagedIn();    ///< Total pages loaded from backing store
     uint64_t getNumPagedOut();   ///< Total pages evicted to backing store
+    uint64_t getNumPageFaults(); ///< Total page faults (requestPage + startPageIn)
+
+    uint64_t getNumReclaimRuns();      ///< Times the background reclaimer woke up
+    uint64_t getNumPagesReclaimed();   ///< Frames freed by the background reclaimer
+    uint64_t getNumDirectReclaims();   ///< Faults that had to evict synchronously
+    size_t getNumPendingPageIns();     ///< Asynchronous page-ins still in flight
+
+    uint64_t getNumLocalReplacements();///< Faults served by evicting the faulting process's own page
+
+    uint64_t getNumForks();            ///< forkMemory() calls
+    uint64_t getNumCowFaults();        ///< Writes that broke a copy-on-write share
+    size_t getNumSharedFrames();       ///< Frames currently mapped by more than one process
+    size_t getNumFramesSaved();        ///< Extra mappings on shared frames (frames a full copy would need)
+    uint64_t getNumMergedPages();      ///< Pages merged by the same-page scanner
+    uint64_t getNumMergeScans();       ///< mergeIdenticalPages() calls
+
+    size_t getNumCodeSegments();       ///< Live shared code segments
+    size_t getSharedCodeFrames();      ///< Frames holding shared code pages
+    uint64_t getNumCodeShares();       ///< Attaches that reused an existing segment
+
+    uint64_t getNumPrepagedPages();    ///< Pages loaded by prepaging
+    uint64_t getPrepageTicks();        ///< Ticks processes stalled on prepage batches
+    uint64_t getNumPrepageHits();      ///< Prepaged pages referenced before eviction
+    uint64_t getNumPrepageWaste();     ///< Prepaged pages freed without being referenced
+
+    uint64_t getNumProcessSwapOuts();  ///< Whole-process swap-outs
+    uint64_t getNumProcessSwapIns();   ///< Batch swap-ins
+    uint64_t getNumBatchSwapInPages(); ///< Pages restored by batch swap-ins
+    uint64_t getBatchSwapInTicks();    ///< Total ticks spent on batch swap-ins
+
+    // Huge frame statistics (all zero when huge-page-frames is 0)
+    size_t getNumHugePages();          ///< Regions currently mapped by a huge frame
+    uint64_t getNumHugePromotions();   ///< Regions promoted to a huge frame
+    uint64_t getNumHugeDemotions();    ///< Huge frames split to evict one page
+    uint64_t getNumHugeFaultsAvoided();///< First references to pages a promotion brought in
+    uint64_t getHugeFillTicks();       ///< Ticks faulting processes waited for promotion fills
+
+    // Shadow policy statistics (all zero when ghost-policies is off)
+    uint64_t getGhostFaults(const std::string& policy); ///< Faults a policy would have taken
+    uint64_t getGhostReferences();     ///< References the ghost caches have seen
+
+    // Pinning statistics (all zero when max-pinned-frames is 0)
+    size_t getNumPinnedFrames();       ///< Frames currently pinned
+    uint64_t getNumPinRejects();       ///< Pins refused because the cap was full
+
+    // File mapping statistics
+    size_t getNumFileMappings();       ///< Live MMAP ranges over all processes
+    uint64_t getNumFilePageIns();      ///< Pages read from mapped files
+    uint64_t getNumFileDrops();        ///< Clean file pages dropped on eviction
+    uint64_t getNumDiscardedPages();   ///< Resident pages given back by discardPages()
+
+    /**
+     * @brief Frames taken out of the frame pool to hold the compressed swap pool
+     * @param settings Configuration the pool is sized from
+     * @return Pool bytes rounded up to whole frames (0 when zswap is off)
+     */
+    static size_t zswapReservedFrames(const Config& settings);
+
+    // Compressed swap pool statistics (all zero when zswap-pool-percent is 0)
+    size_t getZswapPoolBytes();        ///< Compressed bytes currently stored
+    size_t getZswapPoolCapacity();     ///< Pool capacity in bytes
+    size_t getZswapStoredPages();      ///< Pages currently in the pool
+    double getZswapCompressionRatio(); ///< Original / compressed bytes over all stores
+    uint64_t getZswapHits();           ///< Faults served from the pool
+    uint64_t getZswapEvictions();      ///< Pool entries written back to the backing store
+    uint64_t getZswapRejects();        ///< Evicted pages too incompressible to store
+
+    // Paging disk statistics (all zero when the disk model is disabled)
+    size_t getDiskQueueDepth();        ///< Disk requests queued or in service
+    size_t getDiskMaxQueueDepth();     ///< Highest disk queue depth observed
+    uint64_t getDiskNumCompleted();    ///< Disk requests completed
+    double getDiskAvgServiceTicks();   ///< Mean seek + transfer ticks per request
+    double getDiskAvgResponseTicks();  ///< Mean queue wait + service ticks per request
 
 private:
-    MemoryManager() = default;
-    
+    const Config& config;         ///< Settings in effect (the global config for the singleton)
+    const std::atomic<uint64_t>& clock; ///< CPU tick source (global_cpu_tick for the singleton)
+    bool backingStoreLog;         ///< Append page traffic to csopesy-backing-store.txt
+
+    FrameTable frames;            ///< Physical frame pool (chunks materialized on first use)
+    size_t totalFrames = 0;       ///< Frames available to pages (pool frames excluded)
+    size_t zswapFrames = 0;       ///< Frames reserved for the compressed swap pool
+    size_t freeFrames = 0;        ///< Number of frames with owner -1
+    PageTraceWriter trace;        ///< Reference recorder (open while tracing)
+    std::vector<GhostCache> ghosts; ///< One shadow cache per policy (empty when off)
+
+    std::unordered_map<int, std::unordered_set<int>> pinnedPages; ///< [pid] -> pages pinned by PIN
+    std::unordered_map<int, std::pair<int, int>> autoPins; ///< Running pid -> (space, page) auto-pinned
+    size_t pinnedFrameCount = 0;                  ///< Frames with FRAME_PINNED set
+    std::atomic<uint64_t> pinRejectCount{0};      ///< Pins refused at the cap
+
     /**
-     * @struct Frame
-     * @brief Represents one physical memory frame
+     * @struct FileMapping
+     * @brief Read-only view of a host file in a process's address space
      */
-    struct Frame {
-        int frameId;                 ///< Frame index in physical memory
-        int ownerPid;                ///< Process that owns this frame (-1 if free)
-        int pageNum;                 ///< Virtual page number mapped to this frame
-        bool dirty;                  ///< True if frame modified (unused currently)
-        uint64_t allocatedTick;      ///< CPU tick when frame was allocated (for FIFO)
-        uint64_t lastAccessedTick;   ///< CPU tick when frame was last accessed (for LRU)
+    struct FileMapping {
+        std::string path;            ///< Host file
+        int firstPage;               ///< First virtual page of the range
+        int pages;                   ///< Pages in the range
+        uint64_t length;             ///< Mapped bytes (reads past them return 0)
+        uint64_t diskSlot;           ///< Paging-disk slot of the file's first page
     };
-    
-    std::vector<Frame> frames;    ///< Physical frame pool
-    size_t totalFrames = 0;       ///< Total number of frames
+
+    std::unordered_map<int, std::vector<FileMapping>> fileMappings; ///< Mappings per process
+    std::unordered_map<int, std::vector<uint8_t>> fileFrames;     ///< Frame -> file bytes it holds
+    std::atomic<uint64_t> filePageInCount{0};     ///< Pages read from files
+    std::atomic<uint64_t> fileDropCount{0};       ///< File pages evicted without write-back
+    std::atomic<uint64_t> discardedPageCount{0};  ///< Resident pages released by discardPages()
 
     /**
      * @brief Page tables: pageTables[pid][pageNum] = frameIndex
@@ -121,10 +557,121 @@ private:
      */
     std::unordered_map<int, std::unordered_map<int, int>> pageTables;
 
+    /**
+     * @brief Last reference tick per page: pageLastTouched[pid][pageNum] = tick
+     * 
+     * Used to estimate working sets; pages drop out once older than the window.
+     */
+    std::unordered_map<int, std::unordered_map<int, uint64_t>> pageLastTouched;
+
+    /**
+     * @struct PageInRequest
+     * @brief An outstanding asynchronous page-in
+     */
+    struct PageInRequest {
+        int pid;                     ///< Faulting process
+        int pageNum;                 ///< Page to load
+        uint64_t readyTick;          ///< CPU tick at which the page arrives
+        bool loaded = false;         ///< Page mapped; waiting out a huge-frame fill
+    };
+
+    std::unordered_map<uint64_t, PageInRequest> pendingPageIns; ///< In-flight page-ins by request ID
+    uint64_t nextPageInId = 1;    ///< Next page-in request ID
+
+    PagingDisk disk;              ///< Simulated swap device (used if diskScheduler != "none")
+    std::unordered_map<int, uint64_t> swapBase; ///< First backing-store slot of each process
+    uint64_t nextSwapSlot = 0;    ///< Next unreserved backing-store slot
+
+    std::unordered_map<int, std::vector<int>> swappedSets; ///< Pages to restore per swapped-out process
+    std::atomic<uint64_t> processSwapOutCount{0};  ///< Whole-process swap-outs
+    std::atomic<uint64_t> processSwapInCount{0};   ///< Batch swap-ins
+    std::atomic<uint64_t> batchSwapInPages{0};     ///< Pages restored in batches
+    std::atomic<uint64_t> batchSwapInTicks{0};     ///< Ticks spent on batch swap-ins
+
+    std::unordered_map<int, std::vector<int>> prepageSets; ///< Recent pages to prefetch per process
+    std::atomic<uint64_t> prepagedCount{0};        ///< Pages loaded by prepaging
+    std::atomic<uint64_t> prepageTicks{0};         ///< Ticks charged for prepage batches
+    std::atomic<uint64_t> prepageHitCount{0};      ///< Prepaged pages later referenced
+    std::atomic<uint64_t> prepageWasteCount{0};    ///< Prepaged pages freed unreferenced
+
     std::atomic<uint64_t> pagedInCount{0};   ///< Total page-in operations
     std::atomic<uint64_t> pagedOutCount{0};  ///< Total page-out operations
+    std::atomic<uint64_t> pageFaultCount{0}; ///< Total page faults raised
+    std::atomic<uint64_t> localReplacementCount{0}; ///< Own-page evictions at the RSS cap
+    std::atomic<uint64_t> forkCount{0};             ///< Address spaces duplicated by fork
+    std::atomic<uint64_t> cowFaultCount{0};         ///< Copy-on-write breaks
+    std::atomic<uint64_t> mergedPageCount{0};       ///< Duplicate pages merged
+    std::atomic<uint64_t> mergeScanCount{0};        ///< Same-page merge scans
+
+    /**
+     * @struct CodeSegment
+     * @brief Code pages shared by every process running one program
+     * 
+     * The segment has its own page table under a pseudo-pid (<= -2), so its
+     * frames are replaced and paged like any other owner's.
+     */
+    struct CodeSegment {
+        std::string image;           ///< Program text the segment was built from
+        size_t refCount;             ///< Attached processes
+    };
+
+    std::unordered_map<int, CodeSegment> codeSegments;     ///< Live segments by pseudo-pid
+    std::unordered_map<std::string, int> codeSegmentIds;   ///< Program image -> pseudo-pid
+    std::unordered_map<int, int> codeSpaceOf;              ///< Process -> segment pseudo-pid
+    int nextCodeSegmentId = -2;   ///< Next pseudo-pid to hand out (counts down)
+    std::atomic<uint64_t> codeShareCount{0};       ///< Attaches that found an existing segment
+
+    /**
+     * @struct HugeRun
+     * @brief Aligned run of base frames mapping one region as a unit
+     */
+    struct HugeRun {
+        int pid;                     ///< Process the region belongs to
+        int region;                  ///< Region index (first page / hugePageFrames)
+    };
+
+    std::unordered_map<int, HugeRun> hugeRuns;    ///< Huge frames by first frame index
+    std::atomic<uint64_t> hugePromoteCount{0};    ///< Promotions
+    std::atomic<uint64_t> hugeDemoteCount{0};     ///< Demotions under eviction pressure
+    std::atomic<uint64_t> hugeAvoidedCount{0};    ///< Faults saved by promotions
+    std::atomic<uint64_t> hugeFillTicks{0};       ///< Ticks charged for promotion fills
 
-    std::mutex memMutex;          ///< Protects all memory structures
+    static constexpr size_t ZSWAP_HEADER_BYTES = 8;    ///< Fixed cost of one compressed page
+    static constexpr size_t ZSWAP_BYTES_PER_WORD = 4;  ///< Cost per written word (offset + value)
+
+    /**
+     * @struct ZswapEntry
+     * @brief One compressed page held in the pool
+     */
+    struct ZswapEntry {
+        int pid;                     ///< Owning process (or code segment)
+        int pageNum;                 ///< Virtual page number
+        size_t bytes;                ///< Compressed size
+    };
+
+    std::list<ZswapEntry> zswapPool;              ///< Pool contents, oldest first
+    std::unordered_map<int, std::unordered_map<int, std::list<ZswapEntry>::iterator>> zswapIndex; ///< [pid][page] -> entry
+    size_t zswapBytes = 0;                        ///< Compressed bytes in the pool
+    std::unordered_map<int, std::unordered_map<int, std::unordered_set<uint32_t>>> writtenWords; ///< [pid][page] -> written offsets
+    std::atomic<uint64_t> zswapHitCount{0};       ///< Faults served from the pool
+    std::atomic<uint64_t> zswapEvictCount{0};     ///< Writebacks to the backing store
+    std::atomic<uint64_t> zswapRejectCount{0};    ///< Pages sent straight to the backing store
+    std::atomic<uint64_t> zswapStoredOriginal{0}; ///< Uncompressed bytes of every store
+    std::atomic<uint64_t> zswapStoredCompressed{0}; ///< Compressed bytes of every store
+
+    std::unordered_map<int, size_t> rssFrames;      ///< Resident frames per process
+    std::unordered_map<int, size_t> rssLimitFrames; ///< RSS cap in frames per process (0 = none)
+    std::unordered_map<int, uint64_t> faultsByPid; ///< Page faults per process
+
+    std::atomic<uint64_t> reclaimRunCount{0};     ///< Background reclaimer wake-ups
+    std::atomic<uint64_t> pagesReclaimedCount{0}; ///< Frames freed by the reclaimer
+    std::atomic<uint64_t> directReclaimCount{0};  ///< Synchronous evictions in requestPage()
+
+    mutable std::mutex memMutex;  ///< Protects all memory structures
+    std::condition_variable reclaimCv;        ///< Signals the reclaimer (guarded by memMutex)
+    std::atomic<bool> reclaimerStarted{false};///< True once the reclaimer thread exists
+    bool reclaimerStop = false;               ///< Asks the reclaimer to exit (guarded by memMutex)
+    std::thread reclaimerThread;              ///< Background reclaimer (joined on destruction)
 
     /**
      * @brief Convert virtual address to page number
@@ -132,28 +679,244 @@ private:
      * @return Page number (addr / memPerFrame)
      */
     int getPageFromAddress(uint32_t addr);
+
+    /**
+     * @brief Page-table owner an access is translated through
+     * @param pid Process ID
+     * @param codeFetch true for instruction fetches
+     * @return The shared segment's pseudo-pid for code fetches of an
+     *         attached process, otherwise pid
+     */
+    int addressSpace(int pid, bool codeFetch);
+
+    /**
+     * @brief Append a reference to the trace (no-op unless recording)
+     * @param pid Referencing process
+     * @param pageNum Virtual page number
+     * @param access Reference kind
+     * @param flags PAGE_TRACE_* bits
+     */
+    void traceReference(int pid, int pageNum, PageAccess access, uint8_t flags);
+
+    /**
+     * @brief Drop a process's segment reference (memMutex must be held)
+     */
+    void detachCode(int pid);
     
+    /**
+     * @brief Load a page into a free or evicted frame (memMutex must be held)
+     * @param pid Process ID
+     * @param pageNum Page number to load
+     * @return Extra ticks the load takes (reading the rest of a huge frame)
+     * 
+     * No-op if the page is already resident.
+     */
+    uint64_t loadPage(int pid, int pageNum);
+
+    /**
+     * @brief Try to map a faulting page's whole region with a huge frame
+     * @param pid Process ID
+     * @param pageNum Faulting page
+     * @param fillTicks Receives the time to read the region's other missing pages
+     * @return true if the region was promoted (pageNum is now resident)
+     * 
+     * Requires hugePromoteThreshold resident pages in the aligned region
+     * (counting pageNum), no copy-on-write sharing in it, room under the RSS
+     * cap and a fully free aligned run of frames. Resident pages are moved
+     * into the run with their ages; the rest are read in the same batch,
+     * which the faulting process waits for.
+     */
+    bool promoteHuge(int pid, int pageNum, uint64_t& fillTicks);
+
+    /**
+     * @brief Time to read a batch of pages in one go (0 with blocking faults)
+     * @param fromDisk Pages read from the backing store or a mapped file
+     * @param pooled Pages decompressed from the compressed pool
+     * 
+     * One seek plus a transfer per disk page (page-fault-latency once
+     * without the disk model), plus zswap-latency once for pool pages.
+     */
+    uint64_t batchReadTicks(size_t fromDisk, size_t pooled) const;
+
+    /**
+     * @brief Split a huge frame back into base frames
+     * @param runStart First frame of the run
+     * @param pressure true when splitting to evict (counted as a demotion)
+     */
+    void dissolveHuge(int runStart, bool pressure);
+
+    /**
+     * @brief Get an empty frame for a process (memMutex must be held)
+     * @param pid Process that will use the frame
+     * @return Frame index
+     * 
+     * Applies local replacement at the RSS cap, else takes a free frame,
+     * else evicts a global victim (direct reclaim).
+     */
+    int obtainFrame(int pid);
+
+    /**
+     * @brief Local victim for a capped process whose resident pages are all shared
+     * @param pid Process at its RSS cap
+     * @return true if one of pid's copy-on-write mappings was dropped
+     * 
+     * Picks the unpinned shared frame mapped by pid with the smallest tick
+     * (replacement policy order) and unmaps pid from it; the frame stays
+     * resident for its other sharers.
+     */
+    bool unmapSharedVictim(int pid);
+
+    /**
+     * @brief Remove one process's mapping of a shared frame
+     * @param frameIndex Frame mapped by pid and at least one other process
+     * @param pid Process giving up its mapping
+     * @return Page number pid had mapped, or -1 if it did not map the frame
+     * 
+     * If pid owned the frame, the first sharer becomes the owner. The page
+     * becomes non-resident for pid.
+     */
+    int unmapShared(int frameIndex, int pid);
+
+    /**
+     * @brief True if a page is pinned by PIN or by a running process
+     */
+    bool isPinned(int space, int pageNum) const;
+
+    /**
+     * @brief Set or clear FRAME_PINNED to match the frame's mappings
+     * @param frameIndex Frame to update (ignored if -1 or free)
+     * 
+     * A frame is pinned if any page mapped to it is pinned and the cap
+     * has room; a pin that finds the cap full counts as rejected.
+     */
+    void updatePin(int frameIndex);
+
+    /**
+     * @brief Frame a resident page occupies
+     * @return Frame index, or -1 if the page is not resident
+     */
+    int residentFrame(int space, int pageNum) const;
+
+    /**
+     * @brief Forget a process's automatic pin (memMutex must be held)
+     */
+    void dropAutoPin(int pid);
+
+    /**
+     * @brief File mapping covering a page
+     * @return Mapping, or nullptr for anonymous memory
+     */
+    const FileMapping* fileMappingOf(int pid, int pageNum) const;
+
+    /**
+     * @brief Paging-disk slot a page is read from
+     * 
+     * The mapped file's extent for file pages, the swap area otherwise.
+     */
+    uint64_t diskSlot(int pid, int pageNum) const;
+
+    /**
+     * @brief Drop a page's contents and free its frame (memMutex must be held)
+     * @return true if the page was resident
+     */
+    bool discardPage(int pid, int pageNum);
+
+    /**
+     * @brief Add non-resident page-table entries (memMutex must be held)
+     * @return Pages the range spans
+     */
+    size_t reservePages(int space, uint32_t virtualAddress, size_t bytes);
+
+    /**
+     * @brief Create an empty page table and swap area (memMutex must be held)
+     * @param pid Process ID
+     * @param size Memory size in bytes
+     * @param maxRss Resident-set cap in bytes (0 = unlimited)
+     */
+    void createAddressSpace(int pid, size_t size, size_t maxRss);
+
+    /**
+     * @brief True if the paging disk model is enabled
+     */
+    bool diskEnabled() const;
+
+    /**
+     * @brief True if the compressed swap pool is enabled
+     */
+    bool zswapEnabled() const;
+
+    /**
+     * @brief Estimated compressed size of a page
+     * @return ZSWAP_HEADER_BYTES plus ZSWAP_BYTES_PER_WORD per distinct word
+     *         ever written to the page, capped at the page size
+     */
+    size_t compressedSize(int pid, int pageNum);
+
+    /**
+     * @brief Try to keep an evicted page in the compressed pool
+     * @return false if the page does not compress (caller writes it to the
+     *         backing store instead)
+     * 
+     * Makes room by writing the oldest pool entries back to the backing store.
+     */
+    bool zswapStore(int pid, int pageNum);
+
+    /**
+     * @brief Take a page out of the compressed pool
+     * @return true if the page was in the pool
+     */
+    bool zswapLoad(int pid, int pageNum);
+
+    /**
+     * @brief Write the oldest pool entry back to the backing store
+     */
+    void zswapWriteback();
+
+    /**
+     * @brief Forget every pool entry of a process (no writeback)
+     */
+    void zswapDrop(int pid);
+
+    /**
+     * @brief Advance the paging disk to the current tick (memMutex must be held)
+     * 
+     * Completed reads are loaded into frames and removed from pendingPageIns.
+     */
+    void serviceDisk();
+
     /**
      * @brief Find first free frame
      * @return Frame index or -1 if all frames occupied
      */
     int findFreeFrame();
     
+    /**
+     * @brief True if local replacement applies to a process's next fault
+     * 
+     * replacement-scope is local and the process holds its RSS cap.
+     */
+    bool atRssLimit(int pid);
+
     /**
      * @brief Select victim frame for eviction
-     * @return Frame index to evict
+     * @param ownerPid Only consider frames owned by this process (-1 = any)
+     * @return Frame index to evict, or -1 if no frame is occupied and unpinned
      * 
-     * Uses FIFO (smallest allocatedTick) or LRU (smallest lastAccessedTick)
+     * Free and pinned frames are never selected. Uses FIFO (smallest allocatedTick) or LRU (smallest lastAccessedTick)
      * based on config.replacementPolicy.
      */
-    int selectVictimFrame();
+    int selectVictimFrame(int ownerPid = -1);
     
     /**
      * @brief Evict a frame to backing store
      * @param frameIndex Frame to evict
      * 
-     * Updates page table to mark page as not resident.
-     * Logs swap-out to csopesy-backing-store.txt.
+     * Updates page table to mark page as not resident (for every sharer).
+     * A frame inside a huge frame demotes it first, so only one page leaves.
+     * The page goes to the compressed pool if enabled and it fits; otherwise
+     * the swap-out is logged to csopesy-backing-store.txt and dirty pages
+     * queue a write on the paging disk when it is enabled. File-mapped pages
+     * are clean and are simply dropped.
      */
     void swapOut(int frameIndex);
     
@@ -163,8 +926,33 @@ private:
      * @param pageNum Page number to load
      * @param frameIndex Destination frame
      * 
-     * Sets allocatedTick and lastAccessedTick to current global_cpu_tick.
-     * Updates page table mapping. Logs swap-in to backing store file.
+     * Logs swap-in to backing store file, then maps the frame (mapFrame()).
+     * A file-mapped page is read from its host file instead.
      */
     void swapIn(int pid, int pageNum, int frameIndex);
+
+    /**
+     * @brief Assign a frame to a process page
+     * @param pid Process ID
+     * @param pageNum Page number
+     * @param frameIndex Destination frame
+     * 
+     * Sets allocatedTick and lastAccessedTick to current global_cpu_tick.
+     * Updates page table mapping and re-applies any pin on the page.
+     */
+    void mapFrame(int pid, int pageNum, int frameIndex);
+
+    /**
+     * @brief Mark a frame as free (caller must have swapped it out first)
+     * @param frameIndex Frame to release
+     */
+    void releaseFrame(int frameIndex);
+
+    /**
+     * @brief Background reclaimer body (runs in its own thread)
+     * 
+     * Waits on reclaimCv until free frames < low watermark, then evicts
+     * victims until free frames >= high watermark.
+     */
+    void reclaimerLoop();
 };
\ No newline at end of file
@@ -0,0 +1,106 @@
+/**
+ * @file page_trace.cpp
+ * @brief Implementation of the page-reference trace writer and reader
+ */
+
+#include "page_trace.h"
+#include <algorithm>
+
+namespace {
+
+// Little-endian encoding independent of the host byte order
+void putLE(std::vector<unsigned char>& buf, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        buf.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+uint64_t getLE(const unsigned char* bytes, size_t count) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < count; ++i) {
+        value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+}  // namespace
+
+bool PageTraceWriter::open(const std::string& file, uint64_t pageSize) {
+    close();
+
+    out.open(file, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    path = file;
+    records = 0;
+    buffer.clear();
+    buffer.reserve(BUFFER_BYTES + PAGE_TRACE_RECORD_BYTES);
+
+    for (char c : PAGE_TRACE_MAGIC) {
+        buffer.push_back(static_cast<unsigned char>(c));
+    }
+    putLE(buffer, PAGE_TRACE_VERSION, 2);
+    putLE(buffer, PAGE_TRACE_RECORD_BYTES, 2);
+    putLE(buffer, 0, 4);  // Reserved
+    putLE(buffer, pageSize, 8);
+    return true;
+}
+
+void PageTraceWriter::append(const PageTraceRecord& record) {
+    if (!out.is_open()) return;
+
+    putLE(buffer, record.tick, 8);
+    putLE(buffer, static_cast<uint32_t>(record.pid), 4);
+    putLE(buffer, record.pageNum, 4);
+    putLE(buffer, static_cast<uint8_t>(record.access), 1);
+    putLE(buffer, record.flags, 1);
+    records++;
+
+    if (buffer.size() >= BUFFER_BYTES) flush();
+}
+
+void PageTraceWriter::flush() {
+    out.write(reinterpret_cast<const char*>(buffer.data()),
+              static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+void PageTraceWriter::close() {
+    if (!out.is_open()) return;
+    flush();
+    out.close();
+}
+
+bool PageTraceReader::open(const std::string& path) {
+    in.close();
+    in.open(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    unsigned char header[PAGE_TRACE_HEADER_BYTES];
+    if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) return false;
+    if (!std::equal(PAGE_TRACE_MAGIC, PAGE_TRACE_MAGIC + sizeof(PAGE_TRACE_MAGIC), header)) {
+        return false;
+    }
+
+    version = static_cast<uint16_t>(getLE(header + 8, 2));
+    size_t recordBytes = static_cast<size_t>(getLE(header + 10, 2));
+    pageSize = getLE(header + 16, 8);
+    if (version == 0 || recordBytes < PAGE_TRACE_RECORD_BYTES) return false;
+
+    buffer.resize(recordBytes);
+    return true;
+}
+
+bool PageTraceReader::next(PageTraceRecord& record) {
+    if (!in.read(reinterpret_cast<char*>(buffer.data()),
+                 static_cast<std::streamsize>(buffer.size()))) {
+        return false;
+    }
+
+    record.tick = getLE(&buffer[0], 8);
+    record.pid = static_cast<int32_t>(static_cast<uint32_t>(getLE(&buffer[8], 4)));
+    record.pageNum = static_cast<uint32_t>(getLE(&buffer[12], 4));
+    record.access = static_cast<PageAccess>(buffer[16]);
+    record.flags = buffer[17];
+    return true;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file page_trace.h
+ * @brief Binary page-reference trace format, buffered writer and reader
+ *
+ * A trace is the reference string seen by the memory manager: one record
+ * per residency check and one per page load it triggers. Offline tools
+ * can replay it against other policies and memory sizes.
+ *
+ * File layout (all integers little-endian, no padding):
+ *
+ *   Header, 24 bytes
+ *     0   char[8]  magic "MO2TRACE"
+ *     8   uint16   format version (PAGE_TRACE_VERSION)
+ *     10  uint16   record size in bytes (PAGE_TRACE_RECORD_BYTES)
+ *     12  uint32   reserved, 0
+ *     16  uint64   page size in bytes (mem-per-frame)
+ *
+ *   Records, 18 bytes each, until end of file
+ *     0   uint64   CPU tick
+ *     8   int32    pid
+ *     12  uint32   virtual page number
+ *     16  uint8    access type (PageAccess)
+ *     17  uint8    flags (PAGE_TRACE_HIT, PAGE_TRACE_FAULT)
+ *
+ * Reference records (PAGE_TRACE_FAULT clear) come from isPageResident()
+ * and carry PAGE_TRACE_HIT when the page was resident. Fault records come
+ * from requestPage()/startPageIn() and follow the missed reference.
+ * The faulting instruction restarts once the page is in, so the process's
+ * next reference to that page is a retry of the missed one. Retries are
+ * recorded as ordinary references; replay (loadTraceReferences()) drops
+ * them so a fault is not followed by a hit it did not earn.
+ * New fields will only ever be appended to a record under a new version.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @enum PageAccess
+ * @brief Kind of memory reference (values are part of the trace format)
+ */
+enum class PageAccess : uint8_t {
+    READ  = 0,  ///< Data read
+    WRITE = 1,  ///< Data write
+    FETCH = 2   ///< Instruction fetch (may hit a shared code segment)
+};
+
+constexpr char PAGE_TRACE_MAGIC[8] = { 'M', 'O', '2', 'T', 'R', 'A', 'C', 'E' };
+constexpr uint16_t PAGE_TRACE_VERSION = 1;         ///< Current format version
+constexpr size_t PAGE_TRACE_HEADER_BYTES = 24;     ///< Bytes before the first record
+constexpr size_t PAGE_TRACE_RECORD_BYTES = 18;     ///< Bytes per record
+
+constexpr uint8_t PAGE_TRACE_HIT = 1 << 0;    ///< Page was resident
+constexpr uint8_t PAGE_TRACE_FAULT = 1 << 1;  ///< Page load issued for a miss
+
+/**
+ * @struct PageTraceRecord
+ * @brief One decoded trace record
+ */
+struct PageTraceRecord {
+    uint64_t tick;        ///< CPU tick of the reference
+    int32_t pid;          ///< Referencing process
+    uint32_t pageNum;     ///< Virtual page number
+    PageAccess access;    ///< Reference kind
+    uint8_t flags;        ///< PAGE_TRACE_* bits
+};
+
+/**
+ * @class PageTraceWriter
+ * @brief Appends records to a trace file through an in-memory buffer
+ *
+ * Records are encoded into a fixed buffer and written out whenever it
+ * fills, so the per-reference cost is a few byte stores.
+ */
+class PageTraceWriter {
+public:
+    static constexpr size_t BUFFER_BYTES = 64 * 1024;  ///< Flush threshold
+
+    /**
+     * @brief Create (truncate) a trace file and write its header
+     * @param path File to write
+     * @param pageSize Bytes per page, stored in the header
+     * @return false if the file could not be opened
+     */
+    bool open(const std::string& path, uint64_t pageSize);
+
+    /**
+     * @brief Buffer one record (no-op if not open)
+     */
+    void append(const PageTraceRecord& record);
+
+    /**
+     * @brief Flush remaining records and close the file
+     */
+    void close();
+
+    bool isOpen() const { return out.is_open(); }                ///< True while recording
+    const std::string& getPath() const { return path; }          ///< Current or last trace file
+    uint64_t getRecordCount() const { return records; }          ///< Records in the current or last trace
+
+private:
+    std::ofstream out;                   ///< Trace file
+    std::string path;                    ///< Trace file name
+    std::vector<unsigned char> buffer;   ///< Encoded records not yet written
+    uint64_t records = 0;                ///< Records appended since open()
+
+    /**
+     * @brief Write the buffer to the file and empty it
+     */
+    void flush();
+};
+
+/**
+ * @class PageTraceReader
+ * @brief Sequential decoder for trace files
+ *
+ * Accepts any version whose records are at least PAGE_TRACE_RECORD_BYTES
+ * long; fields appended by later versions are skipped.
+ */
+class PageTraceReader {
+public:
+    /**
+     * @brief Open a trace file and check its header
+     * @param path File to read
+     * @return false if the file is missing, truncated or not a trace
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Decode the next record
+     * @param record Receives the record
+     * @return false at end of file (a partial last record is ignored)
+     */
+    bool next(PageTraceRecord& record);
+
+    uint64_t getPageSize() const { return pageSize; }   ///< Page size from the header
+    uint16_t getVersion() const { return version; }     ///< Format version from the header
+
+private:
+    std::ifstream in;                    ///< Trace file
+    uint64_t pageSize = 0;               ///< Bytes per page
+    uint16_t version = 0;                ///< Format version
+    std::vector<unsigned char> buffer;   ///< One raw record (header-declared size)
+};
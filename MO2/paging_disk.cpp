@@ -0,0 +1,142 @@
+/**
+ * @file paging_disk.cpp
+ * @brief Implementation of the simulated paging disk
+ *
+ * Service time of a request = seek (proportional to cylinder distance)
+ * + transfer. Response time additionally includes time spent queued.
+ */
+
+#include "paging_disk.h"
+#include <algorithm>
+
+void PagingDisk::configure(const std::string& pol, uint32_t seek, uint32_t transfer) {
+    policy = pol;
+    seekTicks = seek;
+    transferTicks = transfer;
+
+    queue.clear();
+    busy = false;
+    currentStart = 0;
+    busyUntil = 0;
+    headCylinder = 0;
+    scanUp = true;
+    edgeSeek = 0;
+
+    maxDepth = 0;
+    completed = 0;
+    totalServiceTicks = 0;
+    totalResponseTicks = 0;
+}
+
+uint64_t PagingDisk::cylinderOf(uint64_t slot) {
+    return (slot / DISK_SLOTS_PER_CYLINDER) % DISK_CYLINDERS;
+}
+
+void PagingDisk::submit(const Request& req) {
+    queue.push_back(req);
+    maxDepth = std::max(maxDepth, getQueueDepth());
+}
+
+PagingDisk::Request PagingDisk::pickNext() {
+    auto chosen = queue.begin();
+
+    if (policy == "sstf") {
+        // SSTF: closest cylinder to the head wins (ties keep arrival order)
+        uint64_t best = UINT64_MAX;
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            uint64_t cyl = cylinderOf(it->slot);
+            uint64_t dist = (cyl > headCylinder) ? cyl - headCylinder : headCylinder - cyl;
+            if (dist < best) {
+                best = dist;
+                chosen = it;
+            }
+        }
+    } else if (policy == "scan") {
+        // SCAN (elevator): nearest request in the sweep direction; with
+        // nothing left ahead, the head runs on to the edge cylinder and reverses
+        for (int pass = 0; pass < 2; ++pass) {
+            uint64_t best = UINT64_MAX;
+            auto found = queue.end();
+            for (auto it = queue.begin(); it != queue.end(); ++it) {
+                uint64_t cyl = cylinderOf(it->slot);
+                bool ahead = scanUp ? (cyl >= headCylinder) : (cyl <= headCylinder);
+                if (!ahead) continue;
+                uint64_t dist = scanUp ? cyl - headCylinder : headCylinder - cyl;
+                if (dist < best) {
+                    best = dist;
+                    found = it;
+                }
+            }
+            if (found != queue.end()) {
+                chosen = found;
+                break;
+            }
+            uint64_t edge = scanUp ? DISK_CYLINDERS - 1 : 0;
+            edgeSeek += scanUp ? edge - headCylinder : headCylinder - edge;
+            headCylinder = edge;
+            scanUp = !scanUp;
+        }
+    }
+    // FCFS: front of the queue (default)
+
+    Request req = *chosen;
+    queue.erase(chosen);
+    return req;
+}
+
+void PagingDisk::start(const Request& req, uint64_t startTick) {
+    uint64_t cyl = cylinderOf(req.slot);
+    uint64_t dist = (cyl > headCylinder) ? cyl - headCylinder : headCylinder - cyl;
+
+    // Include any SCAN run to the edge made while picking this request
+    dist += edgeSeek;
+    edgeSeek = 0;
+
+    // Seek cost scales with cylinder distance (rounded up to whole ticks)
+    uint64_t seek = (dist * seekTicks + DISK_CYLINDERS - 1) / DISK_CYLINDERS;
+
+    current = req;
+    currentStart = startTick;
+    busyUntil = startTick + seek + transferTicks;
+    headCylinder = cyl;
+    busy = true;
+}
+
+std::vector<PagingDisk::Request> PagingDisk::advance(uint64_t now) {
+    std::vector<Request> done;
+
+    while (true) {
+        if (busy) {
+            if (busyUntil > now) break;  // Current transfer still in progress
+
+            completed++;
+            totalServiceTicks += busyUntil - currentStart;
+            totalResponseTicks += busyUntil - current.submitTick;
+            done.push_back(current);
+            busy = false;
+        }
+
+        if (queue.empty()) break;
+
+        // Work-conserving: next request starts when the previous one ended
+        Request next = pickNext();
+        start(next, std::max(busyUntil, next.submitTick));
+    }
+
+    return done;
+}
+
+size_t PagingDisk::getQueueDepth() const {
+    return queue.size() + (busy ? 1 : 0);
+}
+
+size_t PagingDisk::getMaxQueueDepth() const { return maxDepth; }
+uint64_t PagingDisk::getNumCompleted() const { return completed; }
+
+double PagingDisk::getAvgServiceTicks() const {
+    return completed ? static_cast<double>(totalServiceTicks) / completed : 0.0;
+}
+
+double PagingDisk::getAvgResponseTicks() const {
+    return completed ? static_cast<double>(totalResponseTicks) / completed : 0.0;
+}
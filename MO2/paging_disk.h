@@ -0,0 +1,115 @@
+/**
+ * @file paging_disk.h
+ * @brief Simulated swap device with a request queue and disk scheduling
+ *
+ * Models a single paging disk: every page-in/page-out is a request that
+ * waits in a queue, then occupies the device for seek + transfer ticks.
+ * Outstanding requests are ordered by FCFS, SSTF or SCAN.
+ */
+
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * @class PagingDisk
+ * @brief Single-head disk model driven by the global CPU tick
+ *
+ * Backing-store slots are laid out on DISK_CYLINDERS cylinders with
+ * DISK_SLOTS_PER_CYLINDER slots each (wrapping around). Moving the head
+ * across the whole disk costs seekTicks; every request additionally costs
+ * transferTicks. The device is work-conserving: a request starts as soon
+ * as the previous one finishes, even between scheduler ticks.
+ */
+class PagingDisk {
+public:
+    static constexpr uint64_t DISK_CYLINDERS = 200;         ///< Cylinders on the device
+    static constexpr uint64_t DISK_SLOTS_PER_CYLINDER = 8;  ///< Page slots per cylinder
+
+    /**
+     * @enum Op
+     * @brief Direction of a page transfer
+     */
+    enum class Op {
+        READ,       ///< Page-in (backing store -> frame)
+        WRITE       ///< Page-out of a dirty frame (frame -> backing store)
+    };
+
+    /**
+     * @struct Request
+     * @brief One queued page transfer
+     */
+    struct Request {
+        uint64_t id;             ///< Caller-assigned request ID
+        int pid;                 ///< Owning process
+        int pageNum;             ///< Virtual page number
+        uint64_t slot;           ///< Backing-store slot (determines cylinder)
+        Op op;                   ///< READ or WRITE
+        uint64_t submitTick;     ///< CPU tick the request was queued
+    };
+
+    /**
+     * @brief Set scheduling policy and timing
+     * @param policy "fcfs", "sstf" or "scan"
+     * @param seekTicks Full-stroke seek time in ticks
+     * @param transferTicks Per-request transfer time in ticks
+     *
+     * Also clears the queue, head position and statistics.
+     */
+    void configure(const std::string& policy, uint32_t seekTicks, uint32_t transferTicks);
+
+    /**
+     * @brief Queue a request
+     * @param req Request to add
+     */
+    void submit(const Request& req);
+
+    /**
+     * @brief Run the device up to (and including) a CPU tick
+     * @param now Current CPU tick
+     * @return Requests that completed on or before now, in completion order
+     */
+    std::vector<Request> advance(uint64_t now);
+
+    size_t getQueueDepth() const;        ///< Requests waiting or in service
+    size_t getMaxQueueDepth() const;     ///< Highest queue depth observed
+    uint64_t getNumCompleted() const;    ///< Requests finished
+    double getAvgServiceTicks() const;   ///< Mean seek + transfer time per request
+    double getAvgResponseTicks() const;  ///< Mean queue wait + service time per request
+
+private:
+    std::string policy = "fcfs";         ///< Queue ordering
+    uint32_t seekTicks = 0;              ///< Full-stroke seek time
+    uint32_t transferTicks = 0;          ///< Per-request transfer time
+
+    std::deque<Request> queue;           ///< Requests not yet started
+    bool busy = false;                   ///< True while a request is in service
+    Request current{};                   ///< Request in service (valid if busy)
+    uint64_t currentStart = 0;           ///< Tick the current request started
+    uint64_t busyUntil = 0;              ///< Tick the current request finishes
+    uint64_t headCylinder = 0;           ///< Cylinder under the head
+    bool scanUp = true;                  ///< SCAN sweep direction
+    uint64_t edgeSeek = 0;               ///< Cylinders travelled to the edge before the next seek
+
+    size_t maxDepth = 0;                 ///< Highest observed queue depth
+    uint64_t completed = 0;              ///< Completed requests
+    uint64_t totalServiceTicks = 0;      ///< Sum of seek + transfer ticks
+    uint64_t totalResponseTicks = 0;     ///< Sum of completion - submit ticks
+
+    /**
+     * @brief Cylinder holding a backing-store slot
+     */
+    static uint64_t cylinderOf(uint64_t slot);
+
+    /**
+     * @brief Remove and return the next request according to the policy
+     */
+    Request pickNext();
+
+    /**
+     * @brief Begin servicing a request at a given tick
+     */
+    void start(const Request& req, uint64_t startTick);
+};
@@ -12,6 +12,8 @@
 #include <random>
 #include <sstream>
 #include <cctype>
+#include <algorithm>
+#include <cmath>
 
 // External references from main.cpp
 extern Config config;
@@ -37,8 +39,6 @@ constexpr int MAX_ARITHMETIC_OPERAND = 50;              ///< Maximum random valu
 constexpr int MIN_SLEEP_TICKS = 1;                      ///< Minimum sleep duration in CPU ticks
 constexpr int MAX_SLEEP_TICKS = 10;                     ///< Maximum sleep duration in CPU ticks
 constexpr int PROBABILITY_DENOMINATOR = 2;              ///< Denominator for 50% probability checks
-constexpr int MAX_MEMORY_SIZE = 4096;                   ///< Max address space for auto-generated READ/WRITE
-constexpr uint32_t SYMBOL_TABLE_BYTES = 64;             ///< Fixed symbol-table size in bytes
 constexpr uint32_t BYTES_PER_UINT16 = 2;                ///< Size of one uint16 variable in bytes
 constexpr int REQUIRED_OPERANDS_FOR_ARITHMETIC = 3;     ///< Number of operands required for ADD/SUBTRACT
 constexpr int CPU_TICK_DELAY_MS = 100;                  ///< Real-time delay per CPU tick (in ms)
@@ -53,10 +53,20 @@ std::mutex queue_mutex;                                 ///< Protects all queues
 
 std::list<Process> ready_queue;                         ///< Processes waiting for CPU
 std::list<Process> sleeping_queue;                      ///< Processes blocked on SLEEP
+std::list<Process> blocked_queue;                       ///< Processes blocked on a page-in
+std::list<Process> suspended_queue;                     ///< Processes deferred/suspended by load control
+std::list<Process> swapped_queue;                       ///< Processes swapped out whole
 std::list<Process> finished_queue;                      ///< Completed processes
 
 std::vector<std::optional<Process>> cpu_cores;          ///< Per-core running process
 
+std::atomic<int> current_mpl(0);                        ///< Admitted, unfinished processes
+std::atomic<int> target_mpl(0);                         ///< Processes whose working sets fit in memory
+std::atomic<uint64_t> total_suspensions(0);             ///< Processes shed by the load controller
+std::atomic<uint64_t> total_dispatches(0);              ///< Processes placed on a core
+std::atomic<uint64_t> total_oom_kills(0);               ///< Processes killed by the OOM killer
+std::string last_oom_victim;                            ///< Name/reason of the latest OOM kill
+
 // ============================================================================
 // Helper functions
 // ============================================================================
@@ -69,10 +79,134 @@ int random_in_range(int min, int max) {
 }
 
 /**
- * @brief Generate a random Hex Address string (e.g., "0x1A4")
+ * @brief Random 64-bit value in [min, max] (memory sizes beyond int range)
  */
-std::string generate_hex_address(int max_mem) {
-    int addr = rand() % max_mem;
+uint64_t random_in_range_u64(uint64_t min, uint64_t max) {
+    static std::mt19937_64 rng(static_cast<uint64_t>(rand()));
+    return std::uniform_int_distribution<uint64_t>(min, max)(rng);
+}
+
+/**
+ * @brief Heap region of a process: the upper half of the data a uint16
+ *        pointer can reach, page aligned (empty if that is under a page)
+ * @param memory_size Process size in bytes
+ * @param base Receives the first heap address (never page 0, so 0 is NULL)
+ * @param end Receives one past the last heap address
+ *
+ * Raw READ/WRITE addresses of generated programs stay out of this range,
+ * so freeing heap pages never destroys data the program wrote directly.
+ */
+void heap_region(uint32_t memory_size, uint32_t& base, uint32_t& end) {
+    uint32_t page_size = static_cast<uint32_t>(config.memPerFrame);
+    end = std::min<uint32_t>(memory_size, UINT16_MAX_VALUE + 1) / page_size * page_size;
+    base = std::max(page_size, end / 2 / page_size * page_size);
+    if (base > end) base = end;
+}
+
+/**
+ * @class AddressGenerator
+ * @brief READ/WRITE address stream of one generated process (address-model)
+ *
+ * Every address lies inside the process's memory_size and outside its
+ * heap region; the models run over the remaining bytes as if contiguous.
+ * - uniform: any word of the process
+ * - sequential: a walk from address 0 in address-stride steps, wrapping at the end
+ * - zipf: a page drawn by rank from a Zipf law with exponent zipf-skew (the
+ *   hottest page is at a random place per process), then any word in it
+ * - phased: any word of a phase-pages window that jumps to a random place
+ *   every phase-length addresses
+ */
+class AddressGenerator {
+public:
+    explicit AddressGenerator(uint32_t process_size)
+        : memory_size(std::max<uint32_t>(raw_size(process_size), 1)),
+          page_size(static_cast<uint32_t>(std::min<uint64_t>(config.memPerFrame, this->memory_size))),
+          num_pages((this->memory_size + page_size - 1) / page_size),
+          hot_rotation(static_cast<uint32_t>(random_in_range_u64(0, num_pages - 1))) {}
+
+    /**
+     * @brief Next address of the stream
+     */
+    uint32_t next() {
+        uint32_t addr = next_raw();
+        return (addr < heap_base) ? addr : addr + (heap_end - heap_base);
+    }
+
+private:
+    uint32_t heap_base = 0;      ///< Heap region skipped by the stream
+    uint32_t heap_end = 0;       ///< One past the heap region
+
+    /**
+     * @brief Bytes of the process outside its heap region (records the region)
+     */
+    uint32_t raw_size(uint32_t process_size) {
+        heap_region(process_size, heap_base, heap_end);
+        return process_size - (heap_end - heap_base);
+    }
+
+    /**
+     * @brief Next offset into the process with the heap region cut out
+     */
+    uint32_t next_raw() {
+        if (config.addressModel == "sequential") {
+            uint32_t addr = static_cast<uint32_t>(cursor);
+            cursor = (cursor + config.addressStride) % memory_size;
+            return addr;
+        }
+        if (config.addressModel == "zipf") {
+            return word_in_pages((zipf_rank() - 1 + hot_rotation) % num_pages, 1);
+        }
+        if (config.addressModel == "phased") {
+            uint32_t window = std::min(config.phasePages, num_pages);
+            if (phase_left == 0) {
+                phase_base = static_cast<uint32_t>(random_in_range_u64(0, num_pages - window));
+                phase_left = config.phaseLength;
+            }
+            phase_left--;
+            return word_in_pages(phase_base, window);
+        }
+        return word_in_pages(0, num_pages);
+    }
+
+    uint32_t memory_size;        ///< Process size in bytes (at least 1)
+    uint32_t page_size;          ///< Page size, capped at the process size
+    uint32_t num_pages;          ///< Pages covering the process
+    uint32_t hot_rotation;       ///< zipf: page holding rank 1
+    uint64_t cursor = 0;         ///< sequential: next address
+    uint32_t phase_base = 0;     ///< phased: first page of the window
+    uint32_t phase_left = 0;     ///< phased: addresses left in this phase
+
+    /**
+     * @brief Random 2-byte-aligned address in pages [first, first + count),
+     *        clipped to the process size
+     */
+    uint32_t word_in_pages(uint32_t first, uint32_t count) const {
+        uint64_t start = static_cast<uint64_t>(first) * page_size;
+        uint64_t end = std::min<uint64_t>(start + static_cast<uint64_t>(count) * page_size, memory_size);
+        uint64_t words = (end - start) / 2;
+        if (words == 0) return static_cast<uint32_t>(start);
+        return static_cast<uint32_t>(start + 2 * random_in_range_u64(0, words - 1));
+    }
+
+    /**
+     * @brief Page rank in [1, num_pages] by inverting the continuous Zipf CDF
+     */
+    uint32_t zipf_rank() const {
+        double u = static_cast<double>(random_in_range_u64(0, UINT32_MAX)) / 4294967296.0;
+        double n = static_cast<double>(num_pages);
+        double s = config.zipfSkew;
+        double rank = (std::abs(s - 1.0) < 1e-9)
+            ? std::pow(n, u)
+            : std::pow(1.0 + u * (std::pow(n, 1.0 - s) - 1.0), 1.0 / (1.0 - s));
+        return static_cast<uint32_t>(std::clamp(rank, 1.0, n));
+    }
+};
+
+/**
+ * @brief Generate the next Hex Address string of a process (e.g., "0x1A4")
+ */
+std::string generate_hex_address(AddressGenerator& addresses) {
+    uint32_t addr = addresses.next();
     std::stringstream ss;
     ss << "0x" << std::uppercase << std::hex << addr;
     return ss.str();
@@ -101,51 +235,62 @@ void log_event(Process& p, uint64_t tick, const std::string& msg) {
 }
 
 /**
- * @brief Process PRINT message with variable concatenation
- * @param message Template message with +varname patterns
- * @param p Process with memory context
- * @return Processed message with variables replaced by their values
+ * @brief Handle a page fault raised by a running process
+ * @param p Faulting process
+ * @param addr Virtual address that is not resident
+ * @param access Reference kind (FETCH if the fault came from fetching the instruction)
  * 
- * Replaces patterns like "+x" with the value of variable x.
- * Auto-initializes undeclared variables to 0.
+ * With page-fault-latency 0 and no paging disk, the page is loaded immediately
+ * and the process stalls on its core for this tick (is_waiting). Otherwise an
+ * asynchronous page-in is queued and the process is marked BLOCKED so the caller can
+ * move it off the core and dispatch someone else.
  */
-std::string process_print_message(std::string message, Process& p) {
-    size_t pos = 0;
-    
-    // Look for pattern: +varname (variable concatenation)
-    // Example: "Result: +x" becomes "Result: 42" if x=42
-    while ((pos = message.find('+', pos)) != std::string::npos) {
-        // Extract variable name after '+'
-        size_t varStart = pos + 1;  // Skip the '+' character
-        size_t varEnd = varStart;
-        
-        // Find the end of the variable name (alphanumeric + underscore)
-        // Stops at first non-identifier character (space, comma, etc.)
-        while (varEnd < message.length() && 
-               (std::isalnum(static_cast<unsigned char>(message[varEnd])) || message[varEnd] == '_')) {
-            varEnd++;
-        }
-        
-        // Only process if we found a valid identifier after '+'
-        if (varEnd > varStart) {
-            std::string varName = message.substr(varStart, varEnd - varStart);
-            
-            // Get variable value (auto-initialize to 0 if not declared)
-            if (p.memory.find(varName) == p.memory.end()) {
-                p.memory[varName] = 0;  // Auto-declare as per specs pg. 3
-            }
-            int varValue = p.memory[varName];
-            
-            // Replace entire "+varName" substring with numeric value
-            // Example: "+x" (3 chars) replaced with "42" (2 chars)
-            message.replace(pos, varEnd - pos, std::to_string(varValue));
-        }
-        
-        // Move to next position to search for more '+' patterns
-        pos++;
+void handle_page_fault(Process& p, uint32_t addr, PageAccess access = PageAccess::READ) {
+    auto& mm = MemoryManager::getInstance();
+
+    if (!mm.isAsyncPaging()) {
+        p.is_waiting = true;  // Mark process as waiting (not executing)
+        mm.requestPage(p.id, addr, access);
+        return;
     }
-    
-    return message;
+
+    p.page_request_id = mm.startPageIn(p.id, addr, access);
+    p.state = ProcessState::BLOCKED;
+}
+
+/**
+ * @brief Create a child of a running process (FORK instruction)
+ * @param p Parent process, already advanced past the FORK
+ * @param current_tick Current global CPU tick
+ * 
+ * The child is a copy of the parent's PCB (symbol table, data, loop state)
+ * that resumes at the same instruction. Resident pages are shared
+ * copy-on-write with the parent. Caller must hold queue_mutex.
+ */
+void fork_process(Process& p, uint64_t current_tick) {
+    int pid = next_process_id++;
+
+    Process child = p;
+    child.id = pid;
+    child.name = p.name + "-" + std::to_string(pid);
+    child.state = ProcessState::READY;
+    child.quantum_ticks_left = 0;
+    child.is_waiting = false;
+    child.page_request_id = 0;
+    child.ws_estimate = 0;
+    child.swap_ready_tick = 0;
+    child.swap_in_cost = 0;
+    child.dispatch_skips = 0;
+    child.exec_log.clear();
+
+    MemoryManager::getInstance().forkMemory(p.id, pid, child.memory_size, child.max_rss);
+
+    log_event(p, current_tick, "FORK -> " + child.name);
+    log_event(child, current_tick, "FORKED from " + p.name);
+    if (verboseMode)
+        std::cout << "\n[Scheduler] Process " << p.name << " forked " << child.name << "." << std::endl;
+
+    admit_process(std::move(child));
 }
 
 /**
@@ -176,6 +321,7 @@ bool ensure_symbol_table_slot(Process& p, const std::string& varName) {
         return false;
     }
 
+    p.symbol_slots[varName] = p.symbol_table_bytes_used;
     p.symbol_table_bytes_used += BYTES_PER_UINT16;
     p.memory[varName] = 0; // initialize to 0
     return true;
@@ -205,6 +351,51 @@ int get_operand_value(const std::string& operand, Process& p) {
     return p.memory[operand];
 }
 
+/**
+ * @brief Process PRINT message with variable concatenation
+ * @param message Template message with +varname patterns
+ * @param p Process with memory context
+ * @return Processed message with variables replaced by their values
+ * 
+ * Replaces patterns like "+x" with the value of variable x.
+ * Auto-initializes undeclared variables to 0.
+ */
+std::string process_print_message(std::string message, Process& p) {
+    size_t pos = 0;
+    
+    // Look for pattern: +varname (variable concatenation)
+    // Example: "Result: +x" becomes "Result: 42" if x=42
+    while ((pos = message.find('+', pos)) != std::string::npos) {
+        // Extract variable name after '+'
+        size_t varStart = pos + 1;  // Skip the '+' character
+        size_t varEnd = varStart;
+        
+        // Find the end of the variable name (alphanumeric + underscore)
+        // Stops at first non-identifier character (space, comma, etc.)
+        while (varEnd < message.length() && 
+               (std::isalnum(static_cast<unsigned char>(message[varEnd])) || message[varEnd] == '_')) {
+            varEnd++;
+        }
+        
+        // Only process if we found a valid identifier after '+'
+        if (varEnd > varStart) {
+            std::string varName = message.substr(varStart, varEnd - varStart);
+            
+            // Get variable value (auto-initialize to 0 if not declared)
+            int varValue = get_operand_value(varName, p);  // Auto-declare as per specs pg. 3
+            
+            // Replace entire "+varName" substring with numeric value
+            // Example: "+x" (3 chars) replaced with "42" (2 chars)
+            message.replace(pos, varEnd - pos, std::to_string(varValue));
+        }
+        
+        // Move to next position to search for more '+' patterns
+        pos++;
+    }
+    
+    return message;
+}
+
 /**
  * @brief Generate random operand (50% variable, 50% literal)
  * @param var_pool Pool of variable names to choose from
@@ -275,6 +466,20 @@ bool parse_hex_address(const std::string& token, uint32_t& out) {
     }
 }
 
+/**
+ * @brief Resolve an address operand: a hex literal or a declared variable
+ *        holding an address (e.g. a MALLOC result).
+ * @return false if the token is neither.
+ */
+bool resolve_address(const std::string& token, const Process& p, uint32_t& out) {
+    if (parse_hex_address(token, out)) return true;
+
+    auto it = p.memory.find(token);
+    if (it == p.memory.end()) return false;
+    out = static_cast<uint32_t>(it->second);
+    return true;
+}
+
 /**
  * @brief Parse semicolon-separated command string into instruction vector
  * @param commands String containing commands separated by semicolons
@@ -401,7 +606,7 @@ void generate_new_process() {
     std::string pname = generate_process_name(pid);
 
     // Calculate random memory size for the process (specs pg. 5)
-    uint32_t mem_size = random_in_range(config.minMemPerProc, config.maxMemPerProc);
+    uint64_t mem_size = random_in_range_u64(config.minMemPerProc, config.maxMemPerProc);
 
     // Admission Control: Reject processes that exceed system memory capacity
     if (mem_size > config.maxOverallMem) {
@@ -421,13 +626,16 @@ void generate_new_process() {
     }
 
     // Create process with allocated memory size
-    Process p(pid, pname, num_instructions, mem_size);
+    // isValidConfig() keeps process sizes within the 32-bit address space
+    Process p(pid, pname, num_instructions, static_cast<uint32_t>(mem_size));
+    p.max_rss = config.maxRssPerProc;
 
     // Notify Memory Manager to initialize page table for this process
-    MemoryManager::getInstance().allocateMemory(pid, mem_size);
+    MemoryManager::getInstance().allocateMemory(pid, mem_size, p.max_rss);
 
     // Prepopulate some variables for use in instructions
     std::vector<std::string> var_pool = { "x", "y", "z", "counter" };
+    AddressGenerator addresses(p.memory_size);
 
     // Generate instruction list
     for (uint32_t i = 0; i < num_instructions; ++i) {
@@ -487,11 +695,11 @@ void generate_new_process() {
                 case 5: //READ
                     ins.op = "READ";
                     ins.args.push_back(var_pool[rand() % var_pool.size()]); // var
-                    ins.args.push_back(generate_hex_address(MAX_MEMORY_SIZE)); 
+                    ins.args.push_back(generate_hex_address(addresses)); 
                     break;
                 case 6: //WRITE
                     ins.op = "WRITE";
-                    ins.args.push_back(generate_hex_address(MAX_MEMORY_SIZE)); 
+                    ins.args.push_back(generate_hex_address(addresses)); 
                     ins.args.push_back(generate_random_operand(var_pool, MAX_DECLARE_VALUE));
                     break;
             }
@@ -501,9 +709,173 @@ void generate_new_process() {
     }
 
 
-    // Add process to ready queue
+    // Add process to ready queue (or defer it under load control)
     std::lock_guard<std::mutex> lock(queue_mutex);
-    ready_queue.push_back(std::move(p));
+    admit_process(std::move(p));
+}
+
+/**
+ * @brief Canonical text of a program, used to find identical programs
+ * @param instructions Instruction list
+ * @return Ops and operands joined with separators that cannot occur in them
+ */
+std::string code_image(const std::vector<Instruction>& instructions) {
+    std::string image;
+    for (const auto& ins : instructions) {
+        image += ins.op;
+        for (const auto& arg : ins.args) {
+            image += '\x1f';
+            image += arg;
+        }
+        image += '\x1e';
+    }
+    return image;
+}
+
+/**
+ * @brief True if an operand names a variable (letter or '_', then alphanumerics)
+ */
+bool is_identifier(const std::string& token) {
+    return !token.empty() &&
+        (std::isalpha(static_cast<unsigned char>(token[0])) || token[0] == '_') &&
+        std::all_of(token.begin(), token.end(), [](unsigned char c) { return std::isalnum(c) || c == '_'; });
+}
+
+/**
+ * @brief Encoded size of an instruction in bytes
+ *
+ * One opcode byte plus its operands: a variable is a 1-byte symbol-table
+ * slot, a numeric literal a uint16, a hex address 4 bytes, and any other
+ * text (PRINT message, MMAP path) a 4-byte pointer into a literal pool.
+ */
+uint32_t encoded_size(const Instruction& ins) {
+    uint32_t bytes = 1;
+    for (const auto& arg : ins.args) {
+        uint32_t addr = 0;
+        bool is_literal = !arg.empty() &&
+            (std::isdigit(static_cast<unsigned char>(arg[0])) || (arg[0] == '-' && arg.size() > 1));
+
+        if (parse_hex_address(arg, addr)) bytes += 4;
+        else if (is_identifier(arg)) bytes += 1;
+        else if (is_literal) bytes += 2;
+        else bytes += 4;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Lay a process's program out as a code segment at code-segment-base
+ */
+void layout_code(Process& p) {
+    p.code_base = config.codeSegmentBase;
+    p.code_offsets.assign(1, 0);
+    for (const auto& ins : p.instructions) {
+        p.code_offsets.push_back(p.code_offsets.back() + encoded_size(ins));
+    }
+}
+
+/**
+ * @brief Virtual address the current instruction is fetched from
+ *        (the last instruction once the program has run off its end)
+ */
+uint32_t instruction_address(const Process& p) {
+    if (p.code_offsets.size() < 2) return p.code_base;
+    size_t index = std::min<size_t>(p.current_instruction, p.code_offsets.size() - 2);
+    return p.code_base + p.code_offsets[index];
+}
+
+/**
+ * @brief Virtual address of the symbol table segment: the page(s) just
+ *        below code-segment-base, so it never overlaps data or the heap
+ */
+uint32_t symbol_table_address() {
+    uint32_t span = (SYMBOL_TABLE_BYTES + config.memPerFrame - 1) / config.memPerFrame * config.memPerFrame;
+    return config.codeSegmentBase - span;
+}
+
+/**
+ * @brief Symbol-table addresses an instruction references
+ * @param p Process whose symbol table is used
+ * @param ins Instruction to inspect
+ * @return (address, written) per symbol-table page touched, one entry per page
+ *
+ * A variable that is not declared yet is placed where its slot would go,
+ * since executing the instruction declares it. Variables that no longer fit
+ * in the table are ignored by the instruction and reference nothing.
+ */
+std::vector<std::pair<uint32_t, bool>> symbol_references(const Process& p, const Instruction& ins) {
+    std::vector<std::pair<std::string, bool>> vars;
+    auto use = [&](size_t i, bool written) {
+        if (i < ins.args.size() && is_identifier(ins.args[i])) vars.push_back({ ins.args[i], written });
+    };
+
+    if (ins.op == "DECLARE") use(0, true);
+    else if (ins.op == "ADD" || ins.op == "SUBTRACT") { use(0, true); use(1, false); use(2, false); }
+    else if (ins.op == "READ" || ins.op == "MALLOC") { use(0, true); use(1, false); }
+    else if (ins.op == "WRITE") { use(0, false); use(1, false); }
+    else if (ins.op == "PIN" || ins.op == "FREE") use(0, false);
+    else if (ins.op == "PRINT" && !ins.args.empty()) {
+        // Same "+name" scan as process_print_message()
+        const std::string& message = ins.args[0];
+        for (size_t pos = message.find('+'); pos != std::string::npos; pos = message.find('+', pos + 1)) {
+            size_t end = pos + 1;
+            while (end < message.length() &&
+                   (std::isalnum(static_cast<unsigned char>(message[end])) || message[end] == '_')) {
+                end++;
+            }
+            if (end > pos + 1) vars.push_back({ message.substr(pos + 1, end - pos - 1), false });
+        }
+    }
+
+    std::vector<std::pair<uint32_t, bool>> refs;
+    std::unordered_map<std::string, uint32_t> pending;  // Slots this instruction would declare
+    uint32_t next_free = p.symbol_table_bytes_used;
+    for (const auto& [name, written] : vars) {
+        uint32_t offset = 0;
+        auto slot = p.symbol_slots.find(name);
+        auto planned = pending.find(name);
+        if (slot != p.symbol_slots.end()) {
+            offset = slot->second;
+        } else if (planned != pending.end()) {
+            offset = planned->second;
+        } else if (next_free + BYTES_PER_UINT16 <= SYMBOL_TABLE_BYTES) {
+            offset = pending[name] = next_free;
+            next_free += BYTES_PER_UINT16;
+        } else {
+            continue;
+        }
+
+        uint32_t addr = p.symbol_table_base + offset;
+        auto same_page = std::find_if(refs.begin(), refs.end(), [&](const auto& ref) {
+            return ref.first / config.memPerFrame == addr / config.memPerFrame;
+        });
+        if (same_page == refs.end()) refs.push_back({ addr, written });
+        else same_page->second = same_page->second || written;
+    }
+    return refs;
+}
+
+void admit_process(Process p) {
+    p.last_run_tick = global_cpu_tick.load();
+
+    // Code pages sit at code-segment-base; processes running the same
+    // program fetch from the same code frames when shared-code is on
+    layout_code(p);
+    MemoryManager::getInstance().attachCode(p.id, code_image(p.instructions),
+                                            p.code_base, p.code_offsets.back());
+
+    // The symbol table is private and pages in on first variable access
+    p.symbol_table_base = symbol_table_address();
+    MemoryManager::getInstance().reserveRange(p.id, p.symbol_table_base, SYMBOL_TABLE_BYTES);
+
+    if (config.loadControl == "off") {
+        ready_queue.push_back(std::move(p));
+        return;
+    }
+
+    // balance_load() decides when there is room for it
+    p.state = ProcessState::SUSPENDED;
+    suspended_queue.push_back(std::move(p));
 }
 
 // ============================================================================
@@ -535,12 +907,454 @@ void check_sleeping() {
     }
 }
 
+/**
+ * @brief Move processes from blocked_queue to ready_queue once their page-in completes
+ */
+void check_blocked() {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+
+    auto& mm = MemoryManager::getInstance();
+
+    auto it = blocked_queue.begin();
+    while (it != blocked_queue.end()) {
+        if (mm.pollPageIn(it->page_request_id)) {
+            if (verboseMode)
+                std::cout << "\n[Scheduler] Process " << it->name
+                          << " page-in complete, READY." << std::endl;
+
+            it->state = ProcessState::READY;
+            it->page_request_id = 0;
+            ready_queue.push_back(std::move(*it));
+            it = blocked_queue.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * @brief Working-set based load control (medium-term admission)
+ * 
+ * Sums the working sets of all admitted processes. If the total exceeds
+ * the frame pool, the youngest ready process is suspended (one per tick)
+ * and its resident pages are swapped out, freeing its frames. Otherwise
+ * suspended processes are resumed in FIFO order while their last known
+ * working set (or the average, for new processes) still fits; a resumed
+ * process gets its pages back in one batch swap-in and waits out its cost
+ * on its next dispatch.
+ * Updates current_mpl and target_mpl for vmstat.
+ */
+void balance_load() {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+
+    // Without load control every admitted process counts; nothing to measure
+    if (config.loadControl == "off") {
+        int active = static_cast<int>(ready_queue.size() + sleeping_queue.size() + blocked_queue.size());
+        for (const auto& core : cpu_cores)
+            if (core.has_value()) active++;
+        current_mpl = active;
+        target_mpl = active;
+        return;
+    }
+
+    auto& mm = MemoryManager::getInstance();
+
+    // Measure demand of admitted processes; keep the previous estimate if a
+    // process has not referenced anything within the window
+    size_t demand = 0;
+    int active = 0;
+    auto measure = [&](Process& p) {
+        size_t ws = mm.getWorkingSetSize(p.id, config.workingSetWindow);
+        if (ws > 0) p.ws_estimate = ws;
+        demand += p.ws_estimate;
+        active++;
+    };
+    for (auto& p : ready_queue) measure(p);
+    for (auto& core : cpu_cores)
+        if (core.has_value()) measure(*core);
+    for (auto& p : sleeping_queue) measure(p);
+    for (auto& p : blocked_queue) measure(p);
+
+    size_t frames = mm.getTotalFrames();
+    size_t avg_ws = (active > 0 && demand > 0) ? std::max<size_t>(1, demand / active) : 1;
+    target_mpl = static_cast<int>(std::max<size_t>(1, frames / avg_ws));
+
+    uint64_t current_tick = global_cpu_tick.load();
+
+    if (demand > frames && active > 1 && !ready_queue.empty()) {
+        // Thrashing: shed the youngest ready process
+        auto victim = std::max_element(ready_queue.begin(), ready_queue.end(),
+            [](const Process& a, const Process& b) { return a.id < b.id; });
+
+        // Release its frames so suspension actually lowers memory pressure
+        size_t pages = mm.swapOutProcess(victim->id);
+
+        if (verboseMode)
+            std::cout << "\n[Scheduler] Process " << victim->name
+                      << " SUSPENDED (working sets " << demand << " > "
+                      << frames << " frames, " << pages << " pages swapped out)." << std::endl;
+
+        log_event(*victim, current_tick, "SUSPENDED by load control, swapped out " +
+                  std::to_string(pages) + " pages");
+        victim->state = ProcessState::SUSPENDED;
+        suspended_queue.push_back(std::move(*victim));
+        ready_queue.erase(victim);
+        total_suspensions++;
+        active--;
+    } else {
+        // Pressure is low enough: admit/resume while working sets fit
+        while (!suspended_queue.empty()) {
+            Process& p = suspended_queue.front();
+            size_t need = (p.ws_estimate > 0) ? p.ws_estimate : avg_ws;
+            if (active > 0 && demand + need > frames) break;
+
+            demand += need;
+            active++;
+
+            // Batch swap-in of the pages taken at suspension
+            uint64_t cost = mm.getSwapInCost(p.id);
+            if (mm.swapInProcess(p.id, cost) > 0) {
+                p.delay_ticks_left += static_cast<uint32_t>(cost);
+            }
+
+            p.state = ProcessState::READY;
+            ready_queue.push_back(std::move(p));
+            suspended_queue.pop_front();
+        }
+    }
+
+    current_mpl = active;
+}
+
+/**
+ * @brief Medium-term scheduler: whole-process swap-out and batch swap-in
+ * 
+ * Swapped processes that can run again (were READY, or their sleep has
+ * expired) start a batch swap-in once enough frames are free (or nothing
+ * else is ready), and return to the ready queue when it completes.
+ * While free frames are below the reclaim low watermark (or exhausted),
+ * the READY/SLEEPING process that has waited longest - at least
+ * swap-out-after ticks - has all of its pages swapped out (one per tick).
+ */
+void medium_term_schedule() {
+    if (config.swapOutAfter == 0) return;
+
+    std::lock_guard<std::mutex> lock(queue_mutex);
+
+    auto& mm = MemoryManager::getInstance();
+    uint64_t current_tick = global_cpu_tick.load();
+
+    // Batch swap-in of runnable swapped processes
+    auto it = swapped_queue.begin();
+    while (it != swapped_queue.end()) {
+        bool runnable = it->swapped_from != ProcessState::SLEEPING ||
+                        current_tick >= it->sleep_until_tick;
+        if (!runnable) {
+            ++it;
+            continue;
+        }
+
+        if (it->swap_ready_tick == 0) {
+            // Wait for room unless the CPUs would otherwise have nothing to run
+            if (mm.getFreeFrameCount() < mm.getSwappedPageCount(it->id) && !ready_queue.empty()) {
+                ++it;
+                continue;
+            }
+            // Priced once: the swapped set can shrink before the batch completes
+            it->swap_in_cost = mm.getSwapInCost(it->id);
+            it->swap_ready_tick = current_tick + it->swap_in_cost;
+        }
+
+        if (current_tick < it->swap_ready_tick) {
+            ++it;
+            continue;
+        }
+
+        uint64_t cost = it->swap_in_cost;
+        size_t pages = mm.swapInProcess(it->id, cost);
+
+        if (verboseMode)
+            std::cout << "\n[Scheduler] Process " << it->name << " SWAPPED IN ("
+                      << pages << " pages, " << cost << " ticks)." << std::endl;
+
+        log_event(*it, current_tick, "SWAPPED IN " + std::to_string(pages) + " pages");
+        it->state = ProcessState::READY;
+        it->swap_ready_tick = 0;
+        it->swap_in_cost = 0;
+        ready_queue.push_back(std::move(*it));
+        it = swapped_queue.erase(it);
+    }
+
+    // Only swap whole processes out under memory pressure
+    size_t pressure_mark = std::max<size_t>(1, config.reclaimLowWatermark);
+    if (mm.getFreeFrameCount() >= pressure_mark) return;
+
+    std::list<Process>* source = nullptr;
+    std::list<Process>::iterator victim;
+    uint64_t longest_wait = 0;
+
+    auto consider = [&](std::list<Process>& queue) {
+        for (auto p = queue.begin(); p != queue.end(); ++p) {
+            uint64_t waited = current_tick - std::min(current_tick, p->last_run_tick);
+            if (waited < config.swapOutAfter || waited < longest_wait) continue;
+            if (mm.getProcessRSS(p->id) == 0) continue;  // Nothing to reclaim
+
+            source = &queue;
+            victim = p;
+            longest_wait = waited;
+        }
+    };
+    consider(sleeping_queue);
+    consider(ready_queue);
+
+    if (source == nullptr) return;
+
+    size_t pages = mm.swapOutProcess(victim->id);
+
+    if (verboseMode)
+        std::cout << "\n[Scheduler] Process " << victim->name << " SWAPPED OUT ("
+                  << pages << " pages, waited " << longest_wait << " ticks)." << std::endl;
+
+    log_event(*victim, current_tick, "SWAPPED OUT " + std::to_string(pages) + " pages");
+    victim->swapped_from = victim->state;
+    victim->state = ProcessState::SWAPPED;
+    victim->swap_ready_tick = 0;
+    victim->swap_in_cost = 0;
+    swapped_queue.push_back(std::move(*victim));
+    source->erase(victim);
+}
+
+/**
+ * @brief OOM killer: kill one process when faulting stays above the threshold
+ * 
+ * Every oom-window ticks, compares the faults raised during the window with
+ * oom-fault-threshold. If exceeded, scores every unfinished process with
+ * the configured oom-killer policy (largest RSS, youngest, or most faults),
+ * kills the highest scorer, releases its memory immediately and records
+ * the kill in its execution log.
+ */
+void check_oom() {
+    static uint64_t window_start_tick = 0;
+    static uint64_t window_start_faults = 0;
+
+    if (config.oomKiller == "off") return;
+
+    auto& mm = MemoryManager::getInstance();
+    uint64_t current_tick = global_cpu_tick.load();
+    if (current_tick - window_start_tick < config.oomWindow) return;
+
+    uint64_t faults = mm.getNumPageFaults();
+    uint64_t window_faults = faults - window_start_faults;
+    window_start_tick = current_tick;
+    window_start_faults = faults;
+
+    if (window_faults <= config.oomFaultThreshold) return;
+
+    std::lock_guard<std::mutex> lock(queue_mutex);
+
+    // Score every unfinished process; remember where it lives
+    Process* victim = nullptr;
+    uint64_t best_score = 0;
+    auto score = [&](Process& p) {
+        uint64_t s = 0;
+        if (config.oomKiller == "rss") s = mm.getProcessRSS(p.id);
+        else if (config.oomKiller == "youngest") s = static_cast<uint64_t>(p.id);
+        else if (config.oomKiller == "faults") s = mm.getProcessFaults(p.id);
+
+        if (victim == nullptr || s > best_score) {
+            victim = &p;
+            best_score = s;
+        }
+    };
+    for (auto& p : ready_queue) score(p);
+    for (auto& core : cpu_cores)
+        if (core.has_value()) score(*core);
+    for (auto& p : sleeping_queue) score(p);
+    for (auto& p : blocked_queue) score(p);
+    for (auto& p : suspended_queue) score(p);
+    for (auto& p : swapped_queue) score(p);
+
+    if (victim == nullptr) return;
+
+    std::ostringstream reason;
+    reason << "OOM-KILLED (" << window_faults << " faults in " << config.oomWindow
+           << " ticks, " << config.oomKiller << " score " << best_score << ")";
+
+    if (verboseMode)
+        std::cout << "\n[Scheduler] Process " << victim->name << " " << reason.str() << "." << std::endl;
+
+    log_event(*victim, current_tick, reason.str());
+    victim->state = ProcessState::OOM_KILLED;
+    mm.deallocateMemory(victim->id);
+    last_oom_victim = victim->name + " " + reason.str();
+    total_oom_kills++;
+
+    // Move the victim out of whichever queue/core holds it
+    Process killed = std::move(*victim);
+    auto remove_from = [&](std::list<Process>& queue) {
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            if (&*it == victim) {
+                queue.erase(it);
+                return true;
+            }
+        }
+        return false;
+    };
+    bool removed = remove_from(ready_queue) || remove_from(sleeping_queue) ||
+                   remove_from(blocked_queue) || remove_from(suspended_queue) ||
+                   remove_from(swapped_queue);
+    if (!removed) {
+        for (auto& core : cpu_cores) {
+            if (core.has_value() && &*core == victim) {
+                core.reset();
+                break;
+            }
+        }
+    }
+    finished_queue.push_back(std::move(killed));
+}
+
+/**
+ * @brief Same-page merging scan (KSM-style)
+ * 
+ * Every ksm-scan-interval ticks, encodes the data of each resident page of
+ * every unfinished process (sorted non-zero (offset, value) pairs, so
+ * untouched pages all encode as the zero page) and hands them to the memory manager,
+ * which merges identical resident pages into one copy-on-write frame.
+ * Runs in the scheduler thread because page contents live in the PCBs.
+ */
+void scan_same_pages() {
+    static uint64_t last_scan_tick = 0;
+
+    if (config.ksmScanInterval == 0 || config.memPerFrame == 0) return;
+
+    uint64_t current_tick = global_cpu_tick.load();
+    if (current_tick - last_scan_tick < config.ksmScanInterval) return;
+    last_scan_tick = current_tick;
+
+    std::lock_guard<std::mutex> lock(queue_mutex);
+
+    auto& mm = MemoryManager::getInstance();
+    std::vector<MemoryManager::PageContent> pages;
+    auto collect = [&](const Process& p) {
+        uint64_t num_pages = (p.memory_size + config.memPerFrame - 1) / config.memPerFrame;
+
+        // Only resident data pages can be merged; pages without written
+        // words encode as the zero page
+        std::unordered_map<int, std::vector<std::pair<uint32_t, uint16_t>>> words;
+        std::vector<int> resident = mm.getResidentPages(p.id);
+        std::erase_if(resident, [num_pages](int page) { return static_cast<uint64_t>(page) >= num_pages; });
+        for (int page : resident) words[page];
+
+        for (const auto& [addr, value] : p.data_memory) {
+            if (value == 0) continue;
+            auto list = words.find(static_cast<int>(addr / config.memPerFrame));
+            if (list == words.end()) continue;
+            list->second.push_back({ static_cast<uint32_t>(addr % config.memPerFrame), value });
+        }
+
+        for (int page : resident) {
+            auto& list = words[page];
+            std::sort(list.begin(), list.end());
+
+            std::string content;
+            for (const auto& [offset, value] : list) {
+                content.append(reinterpret_cast<const char*>(&offset), sizeof(offset));
+                content.append(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+            pages.push_back({ p.id, page, std::move(content) });
+        }
+    };
+
+    for (const auto& p : ready_queue) collect(p);
+    for (const auto& p : sleeping_queue) collect(p);
+    for (const auto& p : blocked_queue) collect(p);
+    for (const auto& p : suspended_queue) collect(p);
+    for (const auto& core : cpu_cores) {
+        if (core.has_value()) collect(*core);
+    }
+
+    size_t freed = mm.mergeIdenticalPages(pages);
+    if (verboseMode && freed > 0)
+        std::cout << "\n[Scheduler] Same-page merging freed " << freed << " frames." << std::endl;
+}
+
+/**
+ * @brief Data addresses a process will touch on its next instruction
+ * @param p Process to inspect
+ * @return The READ/WRITE/PIN address, if any, then the symbol-table pages of
+ *         its variables (instruction fetch not included)
+ */
+std::vector<uint32_t> next_data_addresses(const Process& p) {
+    std::vector<uint32_t> addresses;
+
+    if (p.current_instruction < p.instructions.size()) {
+        const Instruction& ins = p.instructions[p.current_instruction];
+        uint32_t addr = 0;
+        if (ins.op == "READ" && ins.args.size() >= 2 &&
+            resolve_address(ins.args[1], p, addr) && addr < p.memory_size) {
+            addresses.push_back(addr);
+        } else if ((ins.op == "WRITE" || ins.op == "PIN") && !ins.args.empty() &&
+                   resolve_address(ins.args[0], p, addr) && addr < p.memory_size) {
+            addresses.push_back(addr);
+        }
+        for (const auto& ref : symbol_references(p, ins)) {
+            addresses.push_back(ref.first);
+        }
+    }
+    return addresses;
+}
+
+/**
+ * @brief Choose the next ready process to dispatch
+ * @return Iterator into ready_queue (must not be empty)
+ * 
+ * fifo: the queue head. affinity: among the first dispatch-window entries,
+ * the one with the highest resident fraction for its next instruction and
+ * data page (ties go to the earlier entry). A process passed over
+ * dispatch-window times is taken unconditionally, so nothing starves.
+ */
+std::list<Process>::iterator select_ready_process() {
+    if (config.dispatchPolicy != "affinity") {
+        return ready_queue.begin();
+    }
+
+    auto& mm = MemoryManager::getInstance();
+
+    auto best = ready_queue.begin();
+    double best_fraction = -1.0;
+    uint32_t examined = 0;
+    for (auto it = ready_queue.begin();
+         it != ready_queue.end() && examined < config.dispatchWindow;
+         ++it, ++examined) {
+        // Aged out: dispatch regardless of residency
+        if (it->dispatch_skips >= config.dispatchWindow) {
+            best = it;
+            break;
+        }
+
+        double fraction = mm.getResidentFraction(it->id, instruction_address(*it),
+                                                 next_data_addresses(*it));
+        if (fraction > best_fraction) {
+            best_fraction = fraction;
+            best = it;
+        }
+    }
+
+    // Age everyone that was ahead of the chosen process
+    for (auto it = ready_queue.begin(); it != best; ++it) {
+        it->dispatch_skips++;
+    }
+    return best;
+}
+
 /**
  * @brief Dispatch ready processes to available CPU cores
  * 
  * For RR: process quantum is set to quantumCycles.
  * 
- * Pops from front of ready_queue (FIFO order).
+ * Takes the process chosen by select_ready_process() (FIFO order unless
+ * dispatch-policy is affinity).
  */
 void dispatch_processes() {
     std::lock_guard<std::mutex> lock(queue_mutex);
@@ -551,18 +1365,25 @@ void dispatch_processes() {
 
     for (int i = 0; i < cpu_cores.size(); ++i) {
         if (!cpu_cores[i].has_value()) {
-            // Pop process from ready queue (FCFS/FIFO)
-            Process p = std::move(ready_queue.front());
-            ready_queue.pop_front();
+            // Pop process from ready queue (FCFS/FIFO or memory affinity)
+            auto next = select_ready_process();
+            Process p = std::move(*next);
+            ready_queue.erase(next);
 
             // Set process state and initialize quantum
             p.state = ProcessState::RUNNING;
+            p.dispatch_skips = 0;
+            total_dispatches++;
 
             // Set quantum for Round Robin
             if (config.scheduler == "rr") {
                 p.quantum_ticks_left = config.quantumCycles;
             }
 
+            // Bring back the pages it was using when it last left a core;
+            // the process waits on the core while the batch is read
+            p.delay_ticks_left += static_cast<uint32_t>(MemoryManager::getInstance().prepage(p.id));
+
             if (verboseMode) 
                 std::cout << "\n[Scheduler] DISPATCHING " << p.name 
                           << " to CPU " << i << "." << std::endl;
@@ -597,22 +1418,44 @@ void execute_cpu_tick() {
 
             // Reset waiting flag at start of tick (assume process can execute)
             p.is_waiting = false;
+            p.last_run_tick = current_tick;
 
             // MemoryManager integration (page residency check)
-            bool is_resident = MemoryManager::getInstance().isPageResident(p.id, p.current_instruction);
+            uint32_t fetch_address = instruction_address(p);
+            bool is_resident = MemoryManager::getInstance().isPageResident(p.id, fetch_address, PageAccess::FETCH);
             if (!is_resident) {
                 // Page fault - process is waiting for I/O, not executing
-                p.is_waiting = true;
-                MemoryManager::getInstance().requestPage(p.id, p.current_instruction);
+                handle_page_fault(p, fetch_address, PageAccess::FETCH);
                 // Do NOT execute instruction.
                 // Do NOT decrement quantum (stalling).
+            } else {
+                // Keep the page being executed in memory while on the core
+                MemoryManager::getInstance().autoPin(p.id, fetch_address);
+                // Execute one instruction
+                execute_instruction(p, current_tick);
+            }
+
+            // Page fault with non-zero latency: release the core
+            if (p.state == ProcessState::BLOCKED) {
+                if (verboseMode)
+                    std::cout << "\n[Scheduler] Process " << p.name
+                              << " BLOCKED on page fault." << std::endl;
+                MemoryManager::getInstance().recordRecentPages(p.id);
+                MemoryManager::getInstance().unpinDispatch(p.id);
+                blocked_queue.push_back(std::move(p));
+                cpu_cores[i].reset();
                 continue;
             }
 
-            // Execute one instruction
-            execute_instruction(p, current_tick);
+            // Stalled on a blocking page fault this tick
+            if (p.is_waiting) {
+                continue;
+            }
 
+            // An exiting process gives back its frames, copy-on-write
+            // mappings, pins, code reference and ghost-cache entries
             if (p.state == ProcessState::MEMORY_VIOLATED) {
+                MemoryManager::getInstance().deallocateMemory(p.id);
                 finished_queue.push_back(std::move(p));
                 cpu_cores[i].reset();
                 continue;
@@ -620,12 +1463,15 @@ void execute_cpu_tick() {
 
             // Check if process finished or went to sleep (state changed by execute_instruction)
             if (p.state == ProcessState::FINISHED) {
+                MemoryManager::getInstance().deallocateMemory(p.id);
                 finished_queue.push_back(std::move(p));
                 cpu_cores[i].reset();
                 continue;
             }
             
             if (p.state == ProcessState::SLEEPING) {
+                MemoryManager::getInstance().recordRecentPages(p.id);
+                MemoryManager::getInstance().unpinDispatch(p.id);
                 sleeping_queue.push_back(std::move(p));
                 cpu_cores[i].reset();
                 continue;
@@ -645,6 +1491,8 @@ void execute_cpu_tick() {
                                   << " PREEMPTED (RR)." << std::endl;
                     
                     p.state = ProcessState::READY;
+                    MemoryManager::getInstance().recordRecentPages(p.id);
+                    MemoryManager::getInstance().unpinDispatch(p.id);
                     ready_queue.push_back(std::move(p));
                     cpu_cores[i].reset();
                 }
@@ -671,7 +1519,14 @@ void execute_cpu_tick() {
  * - SLEEP <ticks>: Block process for <ticks> CPU ticks (sets state to SLEEPING)
  * - READ <var> <address>: Read from memory address into variable
  * - WRITE <address> <var/value>: Write variable or value to memory address
+ * - PIN <address>: Pin the page holding address in memory until the process ends
+ * - MMAP <address> <path> <len>: Map len bytes of a host file read-only at address
+ * - MALLOC <var> <size>: Allocate a heap block and store its address in var (0 on failure)
+ * - FREE <var>: Free the heap block var points to; emptied pages are given back
  * - FOR <iterations> <block_size>: Loop control
+ * - FORK: Create a child process sharing this one's pages copy-on-write
+ * 
+ * READ, WRITE and PIN accept a variable holding an address in place of a hex literal.
  * 
  * Variables are stored in p.memory (uint16 clamped to [0, 65535]).
  * Undeclared variables auto-initialize to 0.
@@ -708,6 +1563,24 @@ void execute_instruction(Process& p, uint64_t current_tick) {
         log_event(p, current_tick, oss.str());
     }
 
+    // Variables live in the symbol table segment: every page the instruction
+    // reads or writes a variable in must be resident before it executes
+    {
+        auto refs = symbol_references(p, ins);
+        for (const auto& [addr, written] : refs) {
+            PageAccess access = written ? PageAccess::WRITE : PageAccess::READ;
+            if (!MemoryManager::getInstance().isPageResident(p.id, addr, access)) {
+                handle_page_fault(p, addr, access);
+                return;
+            }
+        }
+        for (const auto& [addr, written] : refs) {
+            if (written && MemoryManager::getInstance().markDirty(p.id, addr)) {
+                log_event(p, current_tick, "COW fault in symbol table");
+            }
+        }
+    }
+
     // Execute instruction based on operation
     if (ins.op == "PRINT") {
         // PRINT instruction can handle variable concatenation: PRINT ("Value from: " +x)
@@ -757,7 +1630,7 @@ void execute_instruction(Process& p, uint64_t current_tick) {
             uint32_t addr = 0;
 
             // Validate hex address and bounds
-            if (!parse_hex_address(addrToken, addr) || addr >= p.memory_size) {
+            if (!resolve_address(addrToken, p, addr) || addr >= p.memory_size) {
                 log_event(p, current_tick, "FAULT: invalid READ address " + addrToken);
                 if (verboseMode)
                     std::cout << "[" << p.name << "] MEMORY VIOLATION on READ at "
@@ -771,8 +1644,7 @@ void execute_instruction(Process& p, uint64_t current_tick) {
                 bool is_resident = MemoryManager::getInstance().isPageResident(p.id, addr);
                 if (!is_resident) {
                     // Page fault - request page from disk and stall
-                    p.is_waiting = true;  // Mark process as waiting (not executing)
-                    MemoryManager::getInstance().requestPage(p.id, addr);
+                    handle_page_fault(p, addr);
                     // Do NOT execute instruction - process stalls
                     // Do NOT increment current_instruction
                     // Quantum should NOT be decremented (process is blocked)
@@ -780,12 +1652,14 @@ void execute_instruction(Process& p, uint64_t current_tick) {
                 }
             }
 
-            // Execute the READ operation
+            // Execute the READ operation (file-mapped addresses read the file)
             if (ensure_symbol_table_slot(p, varName)) {
                 uint16_t value = 0;
-                auto it = p.data_memory.find(addr);
-                if (it != p.data_memory.end()) {
-                    value = it->second;
+                if (!MemoryManager::getInstance().readFileWord(p.id, addr, value)) {
+                    auto it = p.data_memory.find(addr);
+                    if (it != p.data_memory.end()) {
+                        value = it->second;
+                    }
                 }
                 p.memory[varName] = clamp_to_uint16(value);
             }
@@ -801,8 +1675,9 @@ void execute_instruction(Process& p, uint64_t current_tick) {
             const std::string& valueToken = ins.args[1];
             uint32_t addr = 0;
 
-            // Validate hex address and bounds
-            if (!parse_hex_address(addrToken, addr) || addr >= p.memory_size) {
+            // Validate hex address and bounds (file mappings are read-only)
+            if (!resolve_address(addrToken, p, addr) || addr >= p.memory_size ||
+                MemoryManager::getInstance().isFileMapped(p.id, addr)) {
                 log_event(p, current_tick, "FAULT: invalid WRITE address " + addrToken);
                 if (verboseMode)
                     std::cout << "[" << p.name << "] MEMORY VIOLATION on WRITE at "
@@ -813,11 +1688,10 @@ void execute_instruction(Process& p, uint64_t current_tick) {
 
             // Memory Manager Integration Hook: check page residency
             {
-                bool is_resident = MemoryManager::getInstance().isPageResident(p.id, addr);
+                bool is_resident = MemoryManager::getInstance().isPageResident(p.id, addr, PageAccess::WRITE);
                 if (!is_resident) {
                     // Page fault - request page from disk and stall
-                    p.is_waiting = true;  // Mark process as waiting (not executing)
-                    MemoryManager::getInstance().requestPage(p.id, addr);
+                    handle_page_fault(p, addr, PageAccess::WRITE);
                     // Do NOT execute instruction - process stalls
                     // Do NOT increment current_instruction
                     // Quantum should NOT be decremented (process is blocked)
@@ -829,6 +1703,138 @@ void execute_instruction(Process& p, uint64_t current_tick) {
             int raw = get_operand_value(valueToken, p);
             uint16_t value = static_cast<uint16_t>(clamp_to_uint16(raw));
             p.data_memory[addr] = value;
+            if (MemoryManager::getInstance().markDirty(p.id, addr)) {
+                log_event(p, current_tick, "COW fault at " + addrToken);
+            }
+        }
+    }
+    else if (ins.op == "PIN") {
+        // PIN <hex_addr>
+        if (ins.args.empty()) {
+            if (verboseMode)
+                std::cout << "[" << p.name << "] ERROR: PIN requires 1 argument (hex_addr)\n";
+        } else {
+            const std::string& addrToken = ins.args[0];
+            uint32_t addr = 0;
+
+            // Validate hex address and bounds
+            if (!resolve_address(addrToken, p, addr) || addr >= p.memory_size) {
+                log_event(p, current_tick, "FAULT: invalid PIN address " + addrToken);
+                if (verboseMode)
+                    std::cout << "[" << p.name << "] MEMORY VIOLATION on PIN at "
+                              << addrToken << " (mem size " << p.memory_size << ")\n";
+                p.state = ProcessState::MEMORY_VIOLATED;
+                return;
+            }
+
+            // The page must be resident before it can be pinned
+            {
+                bool is_resident = MemoryManager::getInstance().isPageResident(p.id, addr);
+                if (!is_resident) {
+                    handle_page_fault(p, addr);
+                    return;
+                }
+            }
+
+            if (!MemoryManager::getInstance().pinPage(p.id, addr)) {
+                log_event(p, current_tick, "PIN rejected at " + addrToken + " (pinned-frame cap full)");
+            }
+        }
+    }
+    else if (ins.op == "MMAP") {
+        // MMAP <hex_addr> <path> <len>
+        if (ins.args.size() < 3) {
+            if (verboseMode)
+                std::cout << "[" << p.name << "] ERROR: MMAP requires 3 arguments (hex_addr, path, len)\n";
+        } else {
+            const std::string& addrToken = ins.args[0];
+            const std::string& path = ins.args[1];
+            uint32_t addr = 0;
+            uint64_t length = 0;
+            try {
+                length = std::stoull(ins.args[2]);
+            } catch (...) {
+                length = 0;
+            }
+
+            // The whole range must lie inside the process's memory
+            if (!parse_hex_address(addrToken, addr) || length == 0 ||
+                addr >= p.memory_size || length > p.memory_size - addr) {
+                log_event(p, current_tick, "FAULT: invalid MMAP range " + addrToken + " " + ins.args[2]);
+                if (verboseMode)
+                    std::cout << "[" << p.name << "] MEMORY VIOLATION on MMAP at "
+                              << addrToken << " (mem size " << p.memory_size << ")\n";
+                p.state = ProcessState::MEMORY_VIOLATED;
+                return;
+            }
+
+            // Live heap blocks cannot be replaced by a mapping
+            if (p.heap.overlapsLive(addr, length)) {
+                log_event(p, current_tick, "MMAP failed for " + path + " at " + addrToken + " (heap in use)");
+            } else if (MemoryManager::getInstance().mapFile(p.id, addr, path, length)) {
+                p.heap.reserve(addr, length);
+                // The range now shows the file, not earlier writes
+                uint64_t end = addr + (length + config.memPerFrame - 1) / config.memPerFrame * config.memPerFrame;
+                std::erase_if(p.data_memory, [addr, end](const auto& word) {
+                    return word.first >= addr && word.first < end;
+                });
+                log_event(p, current_tick, "MMAP " + path + " at " + addrToken);
+            } else {
+                log_event(p, current_tick, "MMAP failed for " + path + " at " + addrToken);
+            }
+        }
+    }
+    else if (ins.op == "MALLOC") {
+        // MALLOC <var> <size/var>
+        if (ins.args.size() < 2) {
+            if (verboseMode)
+                std::cout << "[" << p.name << "] ERROR: MALLOC requires 2 arguments (var, size)\n";
+        } else {
+            const std::string& varName = ins.args[0];
+
+            // The heap gets its own region; file-mapped pages in it are never handed out
+            if (!p.heap.isConfigured()) {
+                uint32_t page_size = static_cast<uint32_t>(config.memPerFrame);
+                uint32_t heap_base = 0, heap_end = 0;
+                heap_region(p.memory_size, heap_base, heap_end);
+                p.heap.configure(heap_base, heap_end, page_size);
+                for (uint32_t page = heap_base; page < heap_end; page += page_size) {
+                    if (MemoryManager::getInstance().isFileMapped(p.id, page)) {
+                        p.heap.reserve(page, page_size);
+                    }
+                }
+            }
+
+            int size = get_operand_value(ins.args[1], p);
+            uint32_t addr = (size >= 0) ? p.heap.allocate(static_cast<uint32_t>(size)) : 0;
+            if (addr == 0) {
+                log_event(p, current_tick, "MALLOC failed for " + std::to_string(size) + " bytes");
+            }
+            if (ensure_symbol_table_slot(p, varName)) {
+                p.memory[varName] = static_cast<int>(addr);
+            }
+        }
+    }
+    else if (ins.op == "FREE") {
+        // FREE <var>
+        if (ins.args.empty()) {
+            if (verboseMode)
+                std::cout << "[" << p.name << "] ERROR: FREE requires 1 argument (var)\n";
+        } else {
+            uint32_t addr = 0;
+            std::vector<uint32_t> freed_pages;
+            if (!resolve_address(ins.args[0], p, addr) || !p.heap.release(addr, freed_pages)) {
+                log_event(p, current_tick, "FREE of invalid pointer " + ins.args[0]);
+            }
+
+            // Emptied heap pages go back to the memory manager (their data is dead)
+            uint32_t page_size = p.heap.getPageSize();
+            for (uint32_t page : freed_pages) {
+                std::erase_if(p.data_memory, [page, page_size](const auto& word) {
+                    return word.first >= page && word.first - page < page_size;
+                });
+                MemoryManager::getInstance().discardPages(p.id, page, page_size);
+            }
         }
     }
     else if (ins.op == "FOR") {
@@ -880,6 +1886,8 @@ void execute_instruction(Process& p, uint64_t current_tick) {
         return;  // Don't increment instruction counter (we already set it)
     }
 
+    bool fork_requested = (ins.op == "FORK");
+
     // Move to next instruction
     p.current_instruction++;
     
@@ -905,6 +1913,11 @@ void execute_instruction(Process& p, uint64_t current_tick) {
     
     // Reset delay counter for next instruction (busy-wait per spec pg. 4)
     p.delay_ticks_left = config.delaysPerExec;
+
+    // Fork last so the child resumes where the parent does
+    if (fork_requested) {
+        fork_process(p, current_tick);
+    }
 }
 // ============================================================================
 // Scheduler main loop
@@ -917,9 +1930,14 @@ void execute_instruction(Process& p, uint64_t current_tick) {
  * 1. Increment global_cpu_tick
  * 2. Generate new process if is_generating_processes and time elapsed >= batchProcessFreq
  * 3. Wake up sleeping processes (check_sleeping)
- * 4. Execute one tick on all running processes (execute_cpu_tick)
- * 5. Dispatch ready processes to idle cores (dispatch_processes)
- * 6. Sleep 100ms (simulates CPU tick delay)
+ * 4. Unblock processes whose page-in completed (check_blocked)
+ * 5. Suspend/resume processes based on working sets (balance_load)
+ * 6. Whole-process swap-out / batch swap-in (medium_term_schedule)
+ * 7. Kill a process if faulting stays above the OOM threshold (check_oom)
+ * 8. Merge identical data pages (scan_same_pages)
+ * 9. Execute one tick on all running processes (execute_cpu_tick)
+ * 10. Dispatch ready processes to idle cores (dispatch_processes)
+ * 11. Sleep 100ms (simulates CPU tick delay)
  * 
  * Only runs when isInitialized is true (guard exists for safety).
  */
@@ -962,6 +1980,11 @@ void scheduler_loop() {
 
             // Process lifecycle management
             check_sleeping();          // Wake up sleeping processes
+            check_blocked();           // Return processes whose page arrived
+            balance_load();            // Working-set load control
+            medium_term_schedule();    // Whole-process swapping
+            check_oom();               // OOM killer
+            scan_same_pages();         // Same-page merging
             execute_cpu_tick();        // Execute instructions
             dispatch_processes();      // Assign ready processes to CPUs
         }
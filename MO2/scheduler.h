@@ -9,6 +9,7 @@
 
 #pragma once
 #include "config.h"
+#include "heap_allocator.h"
 #include <string>
 #include <list>
 #include <vector>
@@ -21,6 +22,10 @@
 extern std::atomic<uint64_t> total_active_ticks; 
 extern std::atomic<uint64_t> total_idle_ticks;
 
+constexpr uint32_t SYMBOL_TABLE_BYTES = 64;  ///< Fixed symbol-table segment size in bytes
+constexpr uint32_t MAX_ENCODED_INSTRUCTION_BYTES = 13;  ///< Opcode byte + up to three 4-byte operands
+constexpr uint32_t MAX_SCREEN_C_INSTRUCTIONS = 50;      ///< Instruction limit of a screen -c program
+
 /**
  * @enum ProcessState
  * @brief Lifecycle states of a process
@@ -31,13 +36,24 @@ extern std::atomic<uint64_t> total_idle_ticks;
  * RUNNING -> FINISHED (all instructions complete)
  * RUNNING -> READY (RR preemption)
  * SLEEPING -> READY (wake up after sleep_until_tick)
+ * RUNNING -> BLOCKED (page fault with page-fault-latency > 0)
+ * BLOCKED -> READY (page-in completed)
+ * READY -> SUSPENDED (load controller sheds load while thrashing)
+ * SUSPENDED -> READY (admitted or resumed once demand fits in memory)
+ * READY/SLEEPING -> SWAPPED (medium-term scheduler, under memory pressure)
+ * SWAPPED -> READY (batch swap-in completed and process is runnable)
+ * any unfinished state -> OOM_KILLED (OOM killer picked it as victim)
  */
 enum class ProcessState {
     READY,              ///< In ready queue, waiting for CPU
     RUNNING,            ///< Currently executing on a CPU core
     SLEEPING,           ///< Blocked, waiting for timer to expire
+    BLOCKED,            ///< Off-core, waiting for a page-in to complete
+    SUSPENDED,          ///< Held back by the load controller (not yet admitted or shed)
+    SWAPPED,            ///< All pages swapped out by the medium-term scheduler
     FINISHED,           ///< All instructions completed
-    MEMORY_VIOLATED     ///< Memory access violation detected
+    MEMORY_VIOLATED,    ///< Memory access violation detected
+    OOM_KILLED          ///< Killed by the OOM killer to stop thrashing
 };
 
 /**
@@ -47,7 +63,7 @@ enum class ProcessState {
  * Supported operations:
  * PRINT, DECLARE, ADD, SUBTRACT, FOR, SLEEP
  * Extended:
- * READ, WRITE
+ * READ, WRITE, FORK, PIN, MMAP, MALLOC, FREE
  */
 struct Instruction {
     std::string op;                      ///< Operation name
@@ -69,7 +85,8 @@ struct LoopStruct {
  * @brief Process control block (PCB)
  * 
  * Variables are uint16 and clamped to 0–65535.
- * Symbol table size is limited to 64 bytes.
+ * Symbol table size is limited to 64 bytes. The table is a segment of the
+ * address space just below the code, so variable accesses fault like data.
  */
 struct Process {
     int id;                              ///< PID
@@ -81,16 +98,31 @@ struct Process {
     uint32_t quantum_ticks_left;         ///< Remaining RR quantum
     uint32_t delay_ticks_left;           ///< Execution delay ticks
     bool is_waiting;                     ///< True if waiting for page fault (not executing)
+    uint64_t page_request_id;            ///< Outstanding page-in while BLOCKED
+    size_t ws_estimate;                  ///< Last measured working set (pages)
+    uint64_t last_run_tick;              ///< Last tick spent on a core (or admission tick)
+    ProcessState swapped_from;           ///< State to resume after a batch swap-in
+    uint64_t swap_ready_tick;            ///< Batch swap-in completion tick (0 = not started)
+    uint64_t swap_in_cost;               ///< Ticks charged for the batch swap-in in progress
+    uint32_t dispatch_skips;             ///< Times affinity dispatch passed this process over
 
     uint32_t memory_size;                ///< Total process memory (bytes)
+    uint32_t max_rss;                    ///< Resident-set cap in bytes (0 = unlimited)
     uint32_t symbol_table_bytes_used;    ///< Bytes used in symbol table (max 64)
 
     // Symbol table: variable name -> uint16 value
     std::unordered_map<std::string, int> memory;
 
+    // Symbol-table byte offset of each variable (declaration order)
+    std::unordered_map<std::string, uint32_t> symbol_slots;
+    uint32_t symbol_table_base;          ///< Virtual address of the symbol table segment
+
     // Simulated process memory for READ/WRITE (address -> uint16)
     std::unordered_map<uint32_t, uint16_t> data_memory;
 
+    // Heap for MALLOC/FREE (configured on first MALLOC)
+    HeapAllocator heap;
+
     // Execution log (instructions executed, faults)
     std::vector<std::string> exec_log;
 
@@ -98,6 +130,8 @@ struct Process {
 
     std::vector<Instruction> instructions; ///< Instruction list
     std::vector<LoopStruct> loop_stack;     ///< FOR-loop stack
+    uint32_t code_base;                     ///< Virtual address of the first instruction
+    std::vector<uint32_t> code_offsets;     ///< Byte offset of each instruction, then the code size
 
     /**
      * @brief Constructor
@@ -112,8 +146,18 @@ struct Process {
           quantum_ticks_left(0),
           delay_ticks_left(0),
           is_waiting(false),
+          page_request_id(0),
+          ws_estimate(0),
+          last_run_tick(0),
+          swapped_from(ProcessState::READY),
+          swap_ready_tick(0),
+          swap_in_cost(0),
+          dispatch_skips(0),
           memory_size(mem_size),
-          symbol_table_bytes_used(0) {}
+          max_rss(0),
+          symbol_table_bytes_used(0),
+          symbol_table_base(0),
+          code_base(0) {}
 };
 
 // ============================================================================
@@ -133,9 +177,20 @@ extern std::atomic<int> next_process_id;
 extern std::mutex queue_mutex;
 extern std::list<Process> ready_queue;
 extern std::list<Process> sleeping_queue;
+extern std::list<Process> blocked_queue;
+extern std::list<Process> suspended_queue;
+extern std::list<Process> swapped_queue;
 extern std::list<Process> finished_queue;
 extern std::vector<std::optional<Process>> cpu_cores;
 
+// Load controller metrics (updated every tick by balance_load)
+extern std::atomic<int> current_mpl;
+extern std::atomic<int> target_mpl;
+extern std::atomic<uint64_t> total_suspensions;
+extern std::atomic<uint64_t> total_dispatches;
+extern std::atomic<uint64_t> total_oom_kills;
+extern std::string last_oom_victim;             ///< Guarded by queue_mutex
+
 // ============================================================================
 // Scheduler interface
 // ============================================================================
@@ -143,6 +198,16 @@ void start_scheduler_thread();
 void start_process_generation();
 void stop_process_generation();
 
+/**
+ * @brief Admit a newly created process
+ * @param p Process to admit
+ * 
+ * With load-control off the process goes straight to the ready queue.
+ * Otherwise it waits in suspended_queue until balance_load() finds room
+ * for its working set. Caller must hold queue_mutex.
+ */
+void admit_process(Process p);
+
 /**
  * @brief Execute one instruction of a process
  * @param p Process reference
@@ -0,0 +1,128 @@
+/**
+ * @file trace_replay.cpp
+ * @brief Implementation of the trace-replay harness
+ */
+
+#include "trace_replay.h"
+#include "memory_manager.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+double ReplayResult::hitRatio() const {
+    return references ? 1.0 - static_cast<double>(faults) / references : 0.0;
+}
+
+double ReplayResult::referencesPerSec() const {
+    return seconds > 0.0 ? references / seconds : 0.0;
+}
+
+bool loadTraceReferences(const std::string& path, std::vector<PageTraceRecord>& references,
+                         uint64_t& pageSize) {
+    PageTraceReader reader;
+    if (!reader.open(path)) return false;
+
+    references.clear();
+    std::unordered_map<int32_t, uint32_t> awaitingRetry;  // pid -> page it faulted on
+    PageTraceRecord record;
+    while (reader.next(record)) {
+        if (record.flags & PAGE_TRACE_FAULT) {
+            awaitingRetry[record.pid] = record.pageNum;
+            continue;
+        }
+
+        // The restarted instruction references the faulted page again; that
+        // repeat is an artifact of the fault, not a reference of its own
+        auto retry = awaitingRetry.find(record.pid);
+        if (retry != awaitingRetry.end() && retry->second == record.pageNum) {
+            awaitingRetry.erase(retry);
+            continue;
+        }
+        references.push_back(record);
+    }
+    pageSize = reader.getPageSize();
+    return true;
+}
+
+size_t countDistinctPages(const std::vector<PageTraceRecord>& references) {
+    std::set<std::pair<int32_t, uint32_t>> pages;
+    for (const auto& ref : references) {
+        pages.insert({ ref.pid, ref.pageNum });
+    }
+    return pages.size();
+}
+
+ReplayResult replayTrace(const std::vector<PageTraceRecord>& references, uint64_t tracePageSize,
+                         const Config& base, const ReplayJob& job) {
+    // Policy and sizes under test; everything that is not replacement is off
+    Config settings = base;
+    settings.replacementPolicy = job.policy;
+    settings.memPerFrame = job.memPerFrame;
+    settings.maxOverallMem = job.memBytes;
+    settings.replacementScope = "global";
+    settings.reclaimLowWatermark = 0;
+    settings.reclaimHighWatermark = 0;
+    settings.pageFaultLatency = 0;
+    settings.diskScheduler = "none";
+    settings.prepagePages = 0;
+    settings.sharedCode = "off";
+    settings.zswapPoolPercent = 0;
+    settings.hugePageFrames = 0;
+    settings.maxPinnedFrames = 0;
+    settings.autoPin = "off";
+
+    std::atomic<uint64_t> tick{0};
+    MemoryManager mm(settings, tick, false);
+    mm.initialize();
+
+    // Address spaces holding exactly the pages each pid touched (code sits far above data)
+    std::unordered_map<int32_t, std::set<uint32_t>> pages;
+    for (const auto& ref : references) {
+        pages[ref.pid].insert(ref.pageNum);
+    }
+    for (const auto& [pid, pageNums] : pages) {
+        mm.allocateMemory(pid, 0);
+        for (uint32_t pageNum : pageNums) {
+            mm.reserveRange(pid, static_cast<uint32_t>(pageNum * tracePageSize), 1);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& ref : references) {
+        tick.store(ref.tick);
+        uint32_t addr = static_cast<uint32_t>(ref.pageNum * tracePageSize);
+        if (!mm.isPageResident(ref.pid, addr, ref.access)) {
+            mm.requestPage(ref.pid, addr, ref.access);
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return { job, mm.getTotalFrames(), references.size(), mm.getNumPageFaults(), elapsed.count() };
+}
+
+std::vector<ReplayResult> replaySweep(const std::vector<PageTraceRecord>& references,
+                                      uint64_t tracePageSize, const Config& base,
+                                      const std::vector<ReplayJob>& jobs, unsigned threads) {
+    std::vector<ReplayResult> results(jobs.size());
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(jobs.size()));
+
+    // Workers pull the next unclaimed job until none are left
+    std::atomic<size_t> nextJob{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (size_t i = nextJob++; i < jobs.size(); i = nextJob++) {
+                results[i] = replayTrace(references, tracePageSize, base, jobs[i]);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return results;
+}
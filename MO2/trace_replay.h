@@ -0,0 +1,85 @@
+/**
+ * @file trace_replay.h
+ * @brief Offline replay of page-reference traces against MemoryManager
+ *
+ * Feeds the references of a recorded trace (see page_trace.h) straight
+ * into standalone MemoryManager instances, without the scheduler, to
+ * compare replacement policies and memory sizes. A sweep runs its
+ * configurations on parallel host threads to build miss-ratio curves.
+ */
+
+#pragma once
+#include "config.h"
+#include "page_trace.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ReplayJob
+ * @brief One configuration to replay a trace against
+ */
+struct ReplayJob {
+    std::string policy;      ///< "fifo" or "lru"
+    uint64_t memPerFrame;    ///< Frame size in bytes
+    uint64_t memBytes;       ///< Simulated physical memory in bytes
+};
+
+/**
+ * @struct ReplayResult
+ * @brief Outcome of replaying a trace under one ReplayJob
+ */
+struct ReplayResult {
+    ReplayJob job;           ///< Configuration replayed
+    size_t frames;           ///< Physical frames (memBytes / memPerFrame)
+    uint64_t references;     ///< References replayed
+    uint64_t faults;         ///< Page faults taken
+    double seconds;          ///< Host wall-clock time of the replay
+
+    double hitRatio() const;       ///< Fraction of references that hit
+    double referencesPerSec() const; ///< Replay throughput
+};
+
+/**
+ * @brief Read the reference records of a trace
+ * @param path Trace file
+ * @param references Receives records without PAGE_TRACE_FAULT (fault records
+ *        are the replayed manager's own business), minus instruction-restart
+ *        retries: the first reference of a pid to the page it just faulted on
+ * @param pageSize Receives the page size the trace was recorded with
+ * @return false if the file is not a readable trace
+ */
+bool loadTraceReferences(const std::string& path, std::vector<PageTraceRecord>& references,
+                         uint64_t& pageSize);
+
+/**
+ * @brief Distinct (pid, page) pairs in a reference string
+ */
+size_t countDistinctPages(const std::vector<PageTraceRecord>& references);
+
+/**
+ * @brief Replay references against a fresh MemoryManager
+ * @param references Reference records, in trace order
+ * @param tracePageSize Page size the trace was recorded with
+ * @param base Configuration to start from (policy and sizes come from job)
+ * @param job Policy and memory sizes to replay with
+ * @return Fault count, hit ratio inputs and timing
+ *
+ * Each pid gets an address space holding exactly the pages it references.
+ * Every miss is served synchronously (no latency, disk, pool, reclaimer,
+ * prepaging, huge frames, code sharing or RSS caps), so the result
+ * reflects the replacement policy alone. Addresses are rebuilt as
+ * page * tracePageSize, so with a smaller mem-per-frame only the first
+ * sub-page of each recorded page is referenced.
+ */
+ReplayResult replayTrace(const std::vector<PageTraceRecord>& references, uint64_t tracePageSize,
+                         const Config& base, const ReplayJob& job);
+
+/**
+ * @brief Replay a set of jobs on parallel host threads
+ * @param threads Worker threads (0 = one per hardware thread)
+ * @return One result per job, in job order
+ */
+std::vector<ReplayResult> replaySweep(const std::vector<PageTraceRecord>& references,
+                                      uint64_t tracePageSize, const Config& base,
+                                      const std::vector<ReplayJob>& jobs, unsigned threads = 0);